@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- BroadcastRingBenchmark -------------------------- */
+
+// Set the number of elements, the ring size and the element types to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 16;
+static constexpr size_t QUEUE_TEST_SIZE = 1 << 10;
+using ElementTestType = float;
+using BlockTestType = std::array<float, 256>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// FAN_OUT_BENCHMARK: Measures delivering every element to every subscriber, against one IESPSCQueue per subscriber.
+#define FAN_OUT_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to deliver N elements from one producer thread to every subscriber thread,
+    where N is defined by the constant ELEMENT_TEST_SIZE, with 1, 2, 4... subscribers up to the number of hardware threads.
+    Each element is either a float or a 1 KiB audio block.
+
+    IEBroadcastRing writes each element once into a single ring of QUEUE_TEST_SIZE elements,
+    while the IESPSCQueue fan-out copies it into one queue of QUEUE_TEST_SIZE elements per subscriber.
+    In Overwrite mode the producer never waits, and the DroppedPerSubscriber counter reports how many elements a subscriber missed.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if FAN_OUT_BENCHMARK
+#define ARGS_B1 Apply([](benchmark::internal::Benchmark* Benchmark) { ApplyThreadsNumRange(Benchmark, { ELEMENT_TEST_SIZE, 0, QUEUE_TEST_SIZE }, 1); })->ArgNames({ "N", "Subscribers", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEBroadcastRing_FanOut,   ElementTestType, IEBroadcastMode::Gated)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IEBroadcastRing_FanOut,   ElementTestType, IEBroadcastMode::Overwrite)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_FanOut,       ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IEBroadcastRing_FanOut,   BlockTestType, IEBroadcastMode::Gated)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IEBroadcastRing_FanOut,   BlockTestType, IEBroadcastMode::Overwrite)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_FanOut,       BlockTestType)->ARGS_B1;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- ByteRingBufferBenchmark -------------------------- */
+
+// Set the number of messages, the largest message size and the memory budget of every queue to be used in the benchmarks. 
+static constexpr size_t MESSAGE_TEST_SIZE = 1 << 18;
+static constexpr size_t MAX_MESSAGE_SIZE = 8192;
+static constexpr size_t BUFFER_TEST_SIZE = 1 << 20;
+static constexpr size_t SMALL_BUFFER_TEST_SIZE = 1 << 12;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// MIXED_SIZES_BENCHMARK: Measures throughput of messages whose sizes range from a few bytes to MAX_MESSAGE_SIZE.
+// LARGEST_RECORDS_BENCHMARK: Measures throughput of records of the largest size wrapping around a small ring.
+#define MIXED_SIZES_BENCHMARK 1
+#define LARGEST_RECORDS_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to move N messages from a producer thread to a consumer thread,
+    where N is defined by the constant MESSAGE_TEST_SIZE. 70% of the messages are under 64 bytes, 25% under 1 KiB
+    and 5% up to MAX_MESSAGE_SIZE bytes. Every queue gets BUFFER_TEST_SIZE bytes of ring storage.
+
+    IEByteRingBuffer stores length-prefixed records in place, and it is compared against an IESPSCQueue of heap allocated messages
+    and an IESPSCQueue whose slots are padded to the largest message, written in place through ReserveWrite/CommitWrite.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if MIXED_SIZES_BENCHMARK
+#define ARGS_B1 Args({ MESSAGE_TEST_SIZE, BUFFER_TEST_SIZE })->ArgNames({ "N", "BufferSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEByteRingBuffer_MixedSizes,  MAX_MESSAGE_SIZE)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_HeapMessages,     MAX_MESSAGE_SIZE)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_MaxSizeMessages,  MAX_MESSAGE_SIZE)->ARGS_B1;
+#endif
+
+/*
+    This benchmark moves N records through a ring of SMALL_BUFFER_TEST_SIZE bytes, alternating 8 byte records
+    with records of IEByteRingBuffer::GetMaxRecordSize(), so the largest records keep needing wrap padding.
+    It never completes if a record of the largest size can fail to fit in an empty ring.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if LARGEST_RECORDS_BENCHMARK
+#define ARGS_B2 Args({ MESSAGE_TEST_SIZE, SMALL_BUFFER_TEST_SIZE })->ArgNames({ "N", "BufferSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK(BM_IEByteRingBuffer_LargestRecords)->ARGS_B2;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- ConcurrentHashMapBenchmark -------------------------- */
+
+// Set the number of operations, the number of keys, the key and value types and the interval between updates to be used in the benchmarks. 
+static constexpr size_t LOOKUP_TEST_SIZE = 1 << 18;
+static constexpr size_t UPDATE_TEST_SIZE = 1 << 12;
+static constexpr size_t SMALL_MAP_TEST_SIZE = 1 << 6;
+static constexpr size_t LARGE_MAP_TEST_SIZE = 1 << 12;
+static constexpr size_t WRITE_INTERVAL_US = 10;
+using KeyTestType = uint32_t;
+using ValueTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// CONCURRENT_LOOKUPS_BENCHMARK: Measures lookup throughput of reader threads while a writer keeps updating values.
+// UPDATES_BENCHMARK: Measures the cost of updating the value of an existing key.
+#define CONCURRENT_LOOKUPS_BENCHMARK 1
+#define UPDATES_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken by the reader threads to each look up N random keys,
+    where N is defined by the constant LOOKUP_TEST_SIZE, while a writer thread updates one value every WRITE_INTERVAL_US microseconds.
+    Each map holds either SMALL_MAP_TEST_SIZE or LARGE_MAP_TEST_SIZE keys.
+
+    IEConcurrentHashMap and a std::unordered_map guarded by a std::shared_mutex run with 1, 2 and 4 readers.
+    A std::unordered_map in an IESpinOnWriteObject, which the writer copies on every update, only supports a single reader.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if CONCURRENT_LOOKUPS_BENCHMARK
+#define ARGS_B1 ArgsProduct({ { LOOKUP_TEST_SIZE }, { 1, 2, 4 }, { WRITE_INTERVAL_US }, { SMALL_MAP_TEST_SIZE, LARGE_MAP_TEST_SIZE } })->ArgNames({ "N", "Readers", "WriteIntervalUs", "Keys" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+#define ARGS_B2 ArgsProduct({ { LOOKUP_TEST_SIZE }, { 1 }, { WRITE_INTERVAL_US }, { SMALL_MAP_TEST_SIZE, LARGE_MAP_TEST_SIZE } })->ArgNames({ "N", "Readers", "WriteIntervalUs", "Keys" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEConcurrentHashMap_ConcurrentLookups,    KeyTestType, ValueTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_SharedMutexMap_ConcurrentLookups,         KeyTestType, ValueTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_SpinOnWriteMap_ConcurrentLookups,         KeyTestType, ValueTestType)->ARGS_B2;
+#endif
+
+/*
+    These benchmarks measure the time taken to update the values of N existing keys on a single thread,
+    where N is defined by the constant UPDATE_TEST_SIZE, in maps of SMALL_MAP_TEST_SIZE or LARGE_MAP_TEST_SIZE keys.
+
+    IEConcurrentHashMap swaps one value and retires the old one, the std::shared_mutex map assigns the value under the exclusive lock,
+    and the IESpinOnWriteObject map copies the whole map on every update.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if UPDATES_BENCHMARK
+#define ARGS_B3 ArgsProduct({ { UPDATE_TEST_SIZE }, { SMALL_MAP_TEST_SIZE, LARGE_MAP_TEST_SIZE } })->ArgNames({ "N", "Keys" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEConcurrentHashMap_Update,   KeyTestType, ValueTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_SharedMutexMap_Update,        KeyTestType, ValueTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_SpinOnWriteMap_Update,        KeyTestType, ValueTestType)->ARGS_B3;
+#endif
+
+BENCHMARK_MAIN();
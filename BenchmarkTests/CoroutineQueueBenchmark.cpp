@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- CoroutineQueueBenchmark -------------------------- */
+
+// Set the number of round trips and the element type to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 16;
+using ElementTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// HANDOFF_LATENCY_BENCHMARK: Measures round trips between coroutines awaiting the queues, against threads blocking on them.
+#define HANDOFF_LATENCY_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken by N round trips between two endpoints, where N is defined by the constant ELEMENT_TEST_SIZE.
+    One endpoint pushes an element to the first queue and waits for the reply on the second queue, the other echoes it back.
+
+    The coroutine benchmarks run both endpoints as coroutines on a single IECoroutineExecutor,
+    awaiting PushAsync and PopAsync on queues of a single element, so every handoff suspends and resumes without switching threads.
+    The thread benchmark runs the same round trips between two threads using PushWait and PopWait.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if HANDOFF_LATENCY_BENCHMARK
+#define ARGS_B1 Arg(ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_CoroutineHandoff,     ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_CoroutineHandoff,     ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_WaitLatency,          ElementTestType)->ARGS_B1;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- HugePageAllocatorBenchmark -------------------------- */
+
+// Set the size and type of elements to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 24;
+using ElementTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// FIRST_PASS_BENCHMARK: Measures the first push and pop pass over a freshly constructed queue.
+// STEADY_STATE_BENCHMARK: Measures push and pop passes over a queue whose buffer has already been touched.
+#define FIRST_PASS_BENCHMARK 1
+#define STEADY_STATE_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to push then pop N elements right after constructing the queue,
+    where N is defined by the constant ELEMENT_TEST_SIZE, so a buffer that isn't pre-faulted pays its page faults during the pass.
+    The ConstructionUs counter reports the time spent constructing the queue, which is where pre-faulting moves that cost.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if FIRST_PASS_BENCHMARK
+#define ARGS_B1(...) Args({ ELEMENT_TEST_SIZE, __VA_ARGS__ })->ArgNames({ "N", "Prefault" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_FirstPass, ElementTestType, std::allocator<ElementTestType>)->ARGS_B1(0);
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_FirstPass, ElementTestType, IEHugePageAllocator<ElementTestType>)->ARGS_B1(0);
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_FirstPass, ElementTestType, IEHugePageAllocator<ElementTestType>)->ARGS_B1(1);
+#endif
+
+/*
+    These benchmarks measure the time taken to push then pop N elements on a queue that has already been filled once,
+    where N is defined by the constant ELEMENT_TEST_SIZE, which isolates the TLB cost of the buffer's page size.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if STEADY_STATE_BENCHMARK
+#define ARGS_B2 Arg(ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_SteadyState, ElementTestType, std::allocator<ElementTestType>)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_SteadyState, ElementTestType, IEHugePageAllocator<ElementTestType>)->ARGS_B2;
+#endif
+
+BENCHMARK_MAIN();
@@ -4,21 +4,40 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <chrono>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <span>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/socket.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
 
 #include "benchmark/benchmark.h"
+#include "boost/lockfree/queue.hpp"
 #include "boost/lockfree/spsc_queue.hpp"
 
 #include "IEConcurrency.h"
 
-template<typename ElementType>
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
 static void BM_IESPSCQueue_Push(benchmark::State& state)
 {
     const unsigned int N = state.range(0);
     for (auto _ : state)
     {
-        IESPSCQueue<ElementType> Queue(N);
+        QueueType Queue(N);
         auto Start = std::chrono::high_resolution_clock::now();
         for (int i = 0; i < N; i++)
         {
@@ -52,13 +71,13 @@ static void BM_BoostSPSCQueue_Push(benchmark::State& state)
     state.SetItemsProcessed(N * state.iterations());
 }
 
-template<typename ElementType>
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
 static void BM_IESPSCQueue_Pop(benchmark::State& state)
 {
     const unsigned int N = state.range(0);
     for (auto _ : state)
     {
-        IESPSCQueue<ElementType> Queue(N);
+        QueueType Queue(N);
         for (int i = 0; i < N; ++i)
         {
             Queue.Push(ElementType());
@@ -78,6 +97,75 @@ static void BM_IESPSCQueue_Pop(benchmark::State& state)
     state.SetItemsProcessed(N * state.iterations());
 }
 
+// Pops into a std::optional, which move-constructs the element in place of default-constructing and assigning it.
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
+static void BM_IESPSCQueue_PopOptional(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    for (auto _ : state)
+    {
+        QueueType Queue(N);
+        for (int i = 0; i < N; ++i)
+        {
+            Queue.Push(ElementType());
+        }
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            std::optional<ElementType> Element = Queue.Pop();
+            benchmark::DoNotOptimize(Element);
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+// Reads the first value of each element in place and discards it, without copying the element out of the queue.
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
+static void BM_IESPSCQueue_Consume(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    for (auto _ : state)
+    {
+        QueueType Queue(N);
+        for (int i = 0; i < N; ++i)
+        {
+            Queue.Push(ElementType());
+        }
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            Queue.Consume([](ElementType& Element) { benchmark::DoNotOptimize(Element[0]); });
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_Pop(benchmark::State& state)
+{
+    BM_IESPSCQueue_Pop<ElementType, IESPMCQueue<ElementType>>(state);
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_PopOptional(benchmark::State& state)
+{
+    BM_IESPSCQueue_PopOptional<ElementType, IESPMCQueue<ElementType>>(state);
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_Consume(benchmark::State& state)
+{
+    BM_IESPSCQueue_Consume<ElementType, IESPMCQueue<ElementType>>(state);
+}
+
 template<typename ElementType>
 static void BM_BoostSPSCQueue_Pop(benchmark::State& state)
 {
@@ -104,11 +192,11 @@ static void BM_BoostSPSCQueue_Pop(benchmark::State& state)
     state.SetItemsProcessed(N * state.iterations());
 }
 
-template<typename ElementType>
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
 static void BM_IESPSCQueue_Latency(benchmark::State& state)
 {
     const unsigned int N = state.range(0);
-    IESPSCQueue<ElementType> Queue1(N), Queue2(N);
+    QueueType Queue1(N), Queue2(N);
     
     for (auto _ : state)
     {
@@ -180,4 +268,2221 @@ static void BM_BoostSPSCQueue_Latency(benchmark::State& state)
         benchmark::ClobberMemory();
     }
     state.SetItemsProcessed(N * state.iterations());
-}
\ No newline at end of file
+}
+
+template<typename ElementType>
+static void BM_IESPSCQueue_PushBulk(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    const std::vector<ElementType> Batch(BatchSize);
+    for (auto _ : state)
+    {
+        IESPSCQueue<ElementType> Queue(N);
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i += BatchSize)
+        {
+            benchmark::DoNotOptimize(Queue.PushBulk(Batch));
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_BoostSPSCQueue_PushBulk(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    const std::vector<ElementType> Batch(BatchSize);
+    for (auto _ : state)
+    {
+        boost::lockfree::spsc_queue<ElementType> Queue(N);
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i += BatchSize)
+        {
+            benchmark::DoNotOptimize(Queue.push(Batch.data(), BatchSize));
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IESPSCQueue_PopBulk(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    std::vector<ElementType> Batch(BatchSize);
+    for (auto _ : state)
+    {
+        IESPSCQueue<ElementType> Queue(N);
+        for (int i = 0; i < N; ++i)
+        {
+            Queue.Push(ElementType());
+        }
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i += BatchSize)
+        {
+            benchmark::DoNotOptimize(Queue.PopBulk(Batch));
+            benchmark::DoNotOptimize(Batch.data());
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_BoostSPSCQueue_PopBulk(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    std::vector<ElementType> Batch(BatchSize);
+    for (auto _ : state)
+    {
+        boost::lockfree::spsc_queue<ElementType> Queue(N);
+        for (int i = 0; i < N; ++i)
+        {
+            Queue.push(ElementType());
+        }
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i += BatchSize)
+        {
+            benchmark::DoNotOptimize(Queue.pop(Batch.data(), BatchSize));
+            benchmark::DoNotOptimize(Batch.data());
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IESPSCQueue_BulkStreaming(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    IESPSCQueue<ElementType> Queue(N);
+
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            std::vector<ElementType> Batch(BatchSize);
+            for (size_t Popped = 0; Popped < N;)
+            {
+                Popped += Queue.PopBulk(Batch);
+                benchmark::DoNotOptimize(Batch.data());
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        const std::vector<ElementType> Batch(BatchSize);
+        for (size_t Pushed = 0; Pushed < N;)
+        {
+            Pushed += Queue.PushBulk(std::span<const ElementType>(Batch).first(std::min<size_t>(BatchSize, N - Pushed)));
+        }
+        Thread.join();
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IESPSCQueue_ReserveCommitStreaming(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    IESPSCQueue<ElementType> Queue(N);
+
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            for (size_t Popped = 0; Popped < N;)
+            {
+                std::span<const ElementType> Region = Queue.ReserveRead(BatchSize);
+                benchmark::DoNotOptimize(Region.data());
+                Queue.CommitRead(Region.size());
+                Popped += Region.size();
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (size_t Pushed = 0; Pushed < N;)
+        {
+            std::span<ElementType> Region = Queue.ReserveWrite(std::min<size_t>(BatchSize, N - Pushed));
+            std::fill(Region.begin(), Region.end(), ElementType());
+            Queue.CommitWrite(Region.size());
+            Pushed += Region.size();
+        }
+        Thread.join();
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_BoostSPSCQueue_BulkStreaming(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BatchSize = state.range(1);
+    boost::lockfree::spsc_queue<ElementType> Queue(N);
+
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            std::vector<ElementType> Batch(BatchSize);
+            for (size_t Popped = 0; Popped < N;)
+            {
+                Popped += Queue.pop(Batch.data(), BatchSize);
+                benchmark::DoNotOptimize(Batch.data());
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        const std::vector<ElementType> Batch(BatchSize);
+        for (size_t Pushed = 0; Pushed < N;)
+        {
+            Pushed += Queue.push(Batch.data(), std::min<size_t>(BatchSize, N - Pushed));
+        }
+        Thread.join();
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+
+template<typename ElementType>
+static void BM_IEMPSCQueue_Throughput(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int ProducersNum = state.range(1);
+    IEMPSCQueue<ElementType> Queue(N);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::vector<std::thread> Producers;
+        for (unsigned int p = 0; p < ProducersNum; p++)
+        {
+            Producers.emplace_back([&, p]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (unsigned int i = p; i < N; i += ProducersNum)
+                {
+                    while (!Queue.Push(ElementType())) {}
+                }
+            });
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (int i = 0; i < N; i++)
+        {
+            ElementType Element;
+            benchmark::DoNotOptimize(Element);
+            while (!Queue.Pop(Element)) {}
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        for (std::thread& Producer : Producers)
+        {
+            Producer.join();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_BoostQueue_MPSCThroughput(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int ProducersNum = state.range(1);
+    boost::lockfree::queue<ElementType> Queue(N);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::vector<std::thread> Producers;
+        for (unsigned int p = 0; p < ProducersNum; p++)
+        {
+            Producers.emplace_back([&, p]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (unsigned int i = p; i < N; i += ProducersNum)
+                {
+                    while (!Queue.bounded_push(ElementType())) {}
+                }
+            });
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (int i = 0; i < N; i++)
+        {
+            ElementType Element;
+            benchmark::DoNotOptimize(Element);
+            while (!Queue.pop(Element)) {}
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        for (std::thread& Producer : Producers)
+        {
+            Producer.join();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+
+// Registers Arguments once per thread count 1, 2, 4... up to the number of hardware threads, written at ThreadsArgumentIndex.
+static inline void ApplyThreadsNumRange(benchmark::internal::Benchmark* Benchmark, std::vector<int64_t> Arguments, size_t ThreadsArgumentIndex)
+{
+    const int64_t HardwareThreadsNum = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    for (int64_t ThreadsNum = 1; ThreadsNum < HardwareThreadsNum; ThreadsNum *= 2)
+    {
+        Arguments[ThreadsArgumentIndex] = ThreadsNum;
+        Benchmark->Args(Arguments);
+    }
+    Arguments[ThreadsArgumentIndex] = HardwareThreadsNum;
+    Benchmark->Args(Arguments);
+}
+
+template<typename ElementType, typename QueueType, typename PushFunction, typename PopFunction>
+static void RunMPMCThroughput(benchmark::State& state, QueueType& Queue, PushFunction Push, PopFunction Pop)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int ProducersNum = state.range(1);
+    const unsigned int ConsumersNum = state.range(2);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::vector<std::thread> Producers, Consumers;
+        for (unsigned int p = 0; p < ProducersNum; p++)
+        {
+            Producers.emplace_back([&, p]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (unsigned int i = p; i < N; i += ProducersNum)
+                {
+                    while (!Push(Queue)) {}
+                }
+            });
+        }
+        for (unsigned int c = 0; c < ConsumersNum; c++)
+        {
+            Consumers.emplace_back([&, c]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (unsigned int i = c; i < N; i += ConsumersNum)
+                {
+                    ElementType Element;
+                    benchmark::DoNotOptimize(Element);
+                    while (!Pop(Queue, Element)) {}
+                }
+            });
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (std::thread& Consumer : Consumers)
+        {
+            Consumer.join();
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        for (std::thread& Producer : Producers)
+        {
+            Producer.join();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+    state.counters["ItemsPerThread"] = benchmark::Counter(static_cast<double>(N) * state.iterations() / (ProducersNum + ConsumersNum), benchmark::Counter::kIsRate);
+}
+
+template<typename ElementType>
+static void BM_IEMPMCQueue_Throughput(benchmark::State& state)
+{
+    IEMPMCQueue<ElementType> Queue(state.range(0));
+    RunMPMCThroughput<ElementType>(state, Queue,
+        [](IEMPMCQueue<ElementType>& Queue) { return Queue.Push(ElementType()); },
+        [](IEMPMCQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); });
+}
+
+template<typename ElementType>
+static void BM_BoostQueue_MPMCThroughput(benchmark::State& state)
+{
+    boost::lockfree::queue<ElementType> Queue(state.range(0));
+    RunMPMCThroughput<ElementType>(state, Queue,
+        [](boost::lockfree::queue<ElementType>& Queue) { return Queue.bounded_push(ElementType()); },
+        [](boost::lockfree::queue<ElementType>& Queue, ElementType& Element) { return Queue.pop(Element); });
+}
+
+
+template<typename ElementType>
+static void BM_IESPSCQueue_WaitLatency(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    IESPSCQueue<ElementType> Queue1(N), Queue2(N);
+    
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            for (int i = 0; i < N; i++)
+            {
+                ElementType Element;
+                benchmark::DoNotOptimize(Element);
+                Queue1.PopWait(Element);
+                Queue2.PushWait(Element);
+            }
+        });
+        
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < N; i++)
+        {
+            Queue1.PushWait(ElementType());
+            ElementType Element;
+            benchmark::DoNotOptimize(Element);
+            Queue2.PopWait(Element);
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        Thread.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<bool bBlockingWait>
+static void BM_IESPSCQueue_RateLimitedWakeUp(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const std::chrono::microseconds Interval(state.range(1));
+    using TimestampType = std::chrono::steady_clock::rep;
+    IESPSCQueue<TimestampType> Queue(N);
+    std::chrono::steady_clock::duration TotalWakeUpLatency{ 0 };
+
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            for (int i = 0; i < N; i++)
+            {
+                TimestampType Timestamp;
+                if constexpr (bBlockingWait)
+                {
+                    Queue.PopWait(Timestamp);
+                }
+                else
+                {
+                    while (!Queue.Pop(Timestamp)) {}
+                }
+                TotalWakeUpLatency += std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(Timestamp);
+            }
+        });
+
+        for (int i = 0; i < N; i++)
+        {
+            std::this_thread::sleep_for(Interval);
+            Queue.Push(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+
+        Thread.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+    state.counters["WakeUpLatencyNs"] = std::chrono::duration<double, std::nano>(TotalWakeUpLatency).count() / (N * state.iterations());
+}
+
+
+/*
+    Log-linear histogram of latencies in nanoseconds, preallocated so that recording never allocates.
+    Values are bucketed by power of two and then linearly into SubBucketsNum sub-buckets,
+    which bounds the relative error of every reported percentile to 1 / SubBucketsNum.
+*/
+class LatencyHistogram
+{
+public:
+    static constexpr size_t SubBucketBits = 5;
+    static constexpr size_t SubBucketsNum = 1 << SubBucketBits;
+    static constexpr size_t BucketsNum = (64 - SubBucketBits + 1) * SubBucketsNum;
+
+public:
+    void Record(uint64_t Value)
+    {
+        m_Counts[GetBucketIndex(Value)]++;
+        m_Num++;
+        m_Max = std::max(m_Max, Value);
+    }
+
+    void Merge(const LatencyHistogram& Other)
+    {
+        for (size_t i = 0; i < BucketsNum; i++)
+        {
+            m_Counts[i] += Other.m_Counts[i];
+        }
+        m_Num += Other.m_Num;
+        m_Max = std::max(m_Max, Other.m_Max);
+    }
+
+    // Returns the upper bound of the bucket holding the given percentile, clamped to the largest recorded value.
+    uint64_t GetPercentile(double Percentile) const
+    {
+        const uint64_t Rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(Percentile / 100.0 * m_Num)), 1);
+        uint64_t CumulativeNum = 0;
+        for (size_t i = 0; i < BucketsNum; i++)
+        {
+            CumulativeNum += m_Counts[i];
+            if (CumulativeNum >= Rank)
+            {
+                return std::min(GetBucketUpperBound(i), m_Max);
+            }
+        }
+        return m_Max;
+    }
+
+    uint64_t GetMax() const
+    {
+        return m_Max;
+    }
+
+private:
+    // Values below SubBucketsNum are exact, larger values keep their SubBucketBits + 1 most significant bits.
+    static size_t GetBucketIndex(uint64_t Value)
+    {
+        if (Value < SubBucketsNum)
+        {
+            return Value;
+        }
+        const size_t Shift = std::bit_width(Value) - SubBucketBits - 1;
+        return (Shift + 1) * SubBucketsNum + (Value >> Shift) - SubBucketsNum;
+    }
+
+    static uint64_t GetBucketUpperBound(size_t Index)
+    {
+        if (Index < SubBucketsNum)
+        {
+            return Index;
+        }
+        const size_t Shift = Index / SubBucketsNum - 1;
+        return ((SubBucketsNum + Index % SubBucketsNum + 1) << Shift) - 1;
+    }
+
+private:
+    std::array<uint64_t, BucketsNum> m_Counts{};
+    uint64_t m_Num = 0;
+    uint64_t m_Max = 0;
+};
+
+/*
+    Timestamps every element with steady_clock at push and records its one-way latency at pop,
+    then reports the p50/p99/p99.9/p99.99/max latencies in nanoseconds as counters.
+    range(1) is the interval between two pushes in nanoseconds, 0 meaning the producer saturates the queue.
+    Rate-limited elements carry their scheduled send time rather than the actual one,
+    so a producer falling behind shows up as latency instead of being silently omitted.
+    Each consumer records into its own histogram, they are merged once the benchmark is done.
+*/
+template<typename ElementType, typename QueueType, typename PushFunction, typename PopFunction>
+static void RunLatencyHistogram(benchmark::State& state, QueueType& Queue, PushFunction Push, PopFunction Pop)
+{
+    const unsigned int N = state.range(0);
+    const std::chrono::nanoseconds Interval(state.range(1));
+    const unsigned int ConsumersNum = state.range(2);
+    static constexpr ElementType StopTimestamp = std::numeric_limits<ElementType>::max();
+    auto Now = [] { return static_cast<ElementType>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); };
+    std::vector<LatencyHistogram> Histograms(ConsumersNum);
+
+    for (auto _ : state)
+    {
+        std::vector<std::thread> Consumers;
+        for (unsigned int c = 0; c < ConsumersNum; c++)
+        {
+            Consumers.emplace_back([&, c]
+            {
+                LatencyHistogram& Histogram = Histograms[c];
+                while (true)
+                {
+                    ElementType Timestamp{};
+                    while (!Pop(Queue, Timestamp)) {}
+                    const ElementType PopTimestamp = Now();
+                    if (Timestamp == StopTimestamp)
+                    {
+                        break;
+                    }
+                    Histogram.Record(PopTimestamp - std::min(Timestamp, PopTimestamp));
+                }
+            });
+        }
+
+        auto Start = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0; i < N; i++)
+        {
+            if (Interval.count() > 0)
+            {
+                const std::chrono::steady_clock::time_point SendTime = Start + i * Interval;
+                while (std::chrono::steady_clock::now() < SendTime)
+                {
+                    IE_CPU_RELAX();
+                }
+                const ElementType Timestamp = static_cast<ElementType>(std::chrono::duration_cast<std::chrono::nanoseconds>(SendTime.time_since_epoch()).count());
+                while (!Push(Queue, Timestamp)) {}
+            }
+            else
+            {
+                while (!Push(Queue, Now())) {}
+            }
+        }
+        for (unsigned int c = 0; c < ConsumersNum; c++)
+        {
+            while (!Push(Queue, StopTimestamp)) {}
+        }
+        for (std::thread& Consumer : Consumers)
+        {
+            Consumer.join();
+        }
+
+        auto End = std::chrono::steady_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+
+    for (unsigned int c = 1; c < ConsumersNum; c++)
+    {
+        Histograms[0].Merge(Histograms[c]);
+    }
+    state.SetItemsProcessed(N * state.iterations());
+    state.counters["p50Ns"] = Histograms[0].GetPercentile(50.0);
+    state.counters["p99Ns"] = Histograms[0].GetPercentile(99.0);
+    state.counters["p99.9Ns"] = Histograms[0].GetPercentile(99.9);
+    state.counters["p99.99Ns"] = Histograms[0].GetPercentile(99.99);
+    state.counters["MaxNs"] = Histograms[0].GetMax();
+}
+
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
+static void BM_IESPSCQueue_LatencyHistogram(benchmark::State& state)
+{
+    QueueType Queue(state.range(3));
+    RunLatencyHistogram<ElementType>(state, Queue,
+        [](QueueType& Queue, ElementType Timestamp) { return Queue.Push(Timestamp); },
+        [](QueueType& Queue, ElementType& Timestamp) { return Queue.Pop(Timestamp); });
+}
+
+template<typename ElementType>
+static void BM_BoostSPSCQueue_LatencyHistogram(benchmark::State& state)
+{
+    boost::lockfree::spsc_queue<ElementType> Queue(state.range(3));
+    RunLatencyHistogram<ElementType>(state, Queue,
+        [](boost::lockfree::spsc_queue<ElementType>& Queue, ElementType Timestamp) { return Queue.push(Timestamp); },
+        [](boost::lockfree::spsc_queue<ElementType>& Queue, ElementType& Timestamp) { return Queue.pop(Timestamp); });
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_LatencyHistogram(benchmark::State& state)
+{
+    IESPMCQueue<ElementType> Queue(state.range(3));
+    RunLatencyHistogram<ElementType>(state, Queue,
+        [](IESPMCQueue<ElementType>& Queue, ElementType Timestamp) { return Queue.Push(Timestamp); },
+        [](IESPMCQueue<ElementType>& Queue, ElementType& Timestamp) { return Queue.Pop(Timestamp); });
+}
+
+template<typename ElementType>
+static void BM_BoostQueue_SPMCLatencyHistogram(benchmark::State& state)
+{
+    boost::lockfree::queue<ElementType> Queue(state.range(3));
+    RunLatencyHistogram<ElementType>(state, Queue,
+        [](boost::lockfree::queue<ElementType>& Queue, ElementType Timestamp) { return Queue.bounded_push(Timestamp); },
+        [](boost::lockfree::queue<ElementType>& Queue, ElementType& Timestamp) { return Queue.pop(Timestamp); });
+}
+
+
+template<typename ReadFunction, typename WriteFunction>
+static void RunConcurrentReadersWithWriter(benchmark::State& state, ReadFunction Read, WriteFunction Write)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int ReadersNum = state.range(1);
+    const std::chrono::microseconds WriteInterval(state.range(2));
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::atomic<bool> bHasFinished{ false };
+        std::vector<std::thread> Readers;
+        for (unsigned int r = 0; r < ReadersNum; r++)
+        {
+            Readers.emplace_back([&]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (unsigned int i = 0; i < N; i++)
+                {
+                    Read();
+                }
+            });
+        }
+        std::thread Writer([&]
+        {
+            while (!bStart.load(std::memory_order_acquire)) {}
+            for (unsigned int i = 0; !bHasFinished.load(std::memory_order_relaxed); i++)
+            {
+                Write(i);
+                std::this_thread::sleep_for(WriteInterval);
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (std::thread& Reader : Readers)
+        {
+            Reader.join();
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        bHasFinished.store(true, std::memory_order_relaxed);
+        Writer.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * ReadersNum * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IEReadMostlyObject_ConcurrentReads(benchmark::State& state)
+{
+    IEReadMostlyObject<ElementType> Object;
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            const auto LockedObject = Object.LockForRead();
+            benchmark::DoNotOptimize(LockedObject.Value[0]);
+        },
+        [&](unsigned int i)
+        {
+            ElementType NewObject{};
+            NewObject[0] = i;
+            Object.Write(NewObject);
+        });
+}
+
+template<typename ElementType>
+static void BM_SharedMutexObject_ConcurrentReads(benchmark::State& state)
+{
+    ElementType Object{};
+    std::shared_mutex Mutex;
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            std::shared_lock Lock(Mutex);
+            benchmark::DoNotOptimize(Object[0]);
+        },
+        [&](unsigned int i)
+        {
+            ElementType NewObject{};
+            NewObject[0] = i;
+            std::unique_lock Lock(Mutex);
+            Object = NewObject;
+        });
+}
+
+
+template<typename ElementType>
+static void BM_IESeqLock_ConcurrentReads(benchmark::State& state)
+{
+    IESeqLock<ElementType> Object;
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            const ElementType Value = Object.Read();
+            benchmark::DoNotOptimize(Value);
+        },
+        [&](unsigned int i)
+        {
+            ElementType NewObject{};
+            NewObject[0] = i;
+            Object.Write(NewObject);
+        });
+}
+
+template<typename ElementType>
+static void BM_IESpinOnWriteObject_ConcurrentReads(benchmark::State& state)
+{
+    IESpinOnWriteObject<ElementType, IESpinOnWriteStorage::Preallocated> Object;
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            const auto LockedObject = Object.LockForRead();
+            const ElementType Value = LockedObject.Value;
+            benchmark::DoNotOptimize(Value);
+        },
+        [&](unsigned int i)
+        {
+            ElementType NewObject{};
+            NewObject[0] = i;
+            Object.Write(NewObject);
+        });
+}
+
+
+template<typename ElementType, IESpinOnWriteStorage Storage>
+static void BM_IESpinOnWriteObject_Write(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject(state.range(1));
+    IESpinOnWriteObject<ElementType, Storage> Object(NewObject);
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            Object.Write(NewObject);
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType, IESpinOnWriteStorage Storage>
+static void BM_IESpinOnWriteObject_ReadLatency(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject(state.range(1));
+    IESpinOnWriteObject<ElementType, Storage> Object(NewObject);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bHasFinished{ false };
+        std::thread Writer([&]
+        {
+            while (!bHasFinished.load(std::memory_order_relaxed))
+            {
+                Object.Write(NewObject);
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < N; i++)
+        {
+            const auto LockedObject = Object.LockForRead();
+            benchmark::DoNotOptimize(LockedObject.Value.data());
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        bHasFinished.store(true, std::memory_order_relaxed);
+        Writer.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IETripleBuffer_Write(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject(state.range(1));
+    IETripleBuffer<ElementType> TripleBuffer(NewObject);
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            TripleBuffer.Write(NewObject);
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IETripleBuffer_ReadLatency(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject(state.range(1));
+    IETripleBuffer<ElementType> TripleBuffer(NewObject);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bHasFinished{ false };
+        std::thread Writer([&]
+        {
+            while (!bHasFinished.load(std::memory_order_relaxed))
+            {
+                TripleBuffer.Write(NewObject);
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < N; i++)
+        {
+            TripleBuffer.Update();
+            benchmark::DoNotOptimize(TripleBuffer.GetReadBuffer().data());
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        bHasFinished.store(true, std::memory_order_relaxed);
+        Writer.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IEThreadPool_ParallelFor(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int WorkersNum = state.range(1);
+    const unsigned int Grain = state.range(2);
+    IEThreadPool ThreadPool(WorkersNum);
+    std::vector<ElementType> Input(N, ElementType(2));
+    std::vector<ElementType> Output(N);
+
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        ThreadPool.ParallelFor(0, N, Grain, [&](size_t i)
+        {
+            Output[i] = std::sqrt(Input[i]) * std::sin(Input[i] + i);
+        });
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::DoNotOptimize(Output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static ElementType ParallelFib(IEThreadPool& ThreadPool, unsigned int Index, unsigned int SerialIndex)
+{
+    if (Index <= SerialIndex)
+    {
+        return Index < 2 ? Index : ParallelFib<ElementType>(ThreadPool, Index - 1, SerialIndex) + ParallelFib<ElementType>(ThreadPool, Index - 2, SerialIndex);
+    }
+
+    ElementType A = 0, B = 0;
+    ThreadPool.Invoke([&] { A = ParallelFib<ElementType>(ThreadPool, Index - 1, SerialIndex); }, [&] { B = ParallelFib<ElementType>(ThreadPool, Index - 2, SerialIndex); });
+    return A + B;
+}
+
+template<typename ElementType>
+static void BM_IEThreadPool_Fib(benchmark::State& state)
+{
+    const unsigned int Index = state.range(0);
+    const unsigned int WorkersNum = state.range(1);
+    const unsigned int SerialIndex = state.range(2);
+    IEThreadPool ThreadPool(WorkersNum);
+
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        benchmark::DoNotOptimize(ParallelFib<ElementType>(ThreadPool, Index, SerialIndex));
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename ElementType, typename AllocatorType>
+static void BM_Allocator_AllocateDeallocate(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    AllocatorType Allocator;
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            ElementType* Element = std::allocator_traits<AllocatorType>::allocate(Allocator, 1);
+            benchmark::DoNotOptimize(Element);
+            std::allocator_traits<AllocatorType>::deallocate(Allocator, Element, 1);
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType, typename AllocatorType>
+static void BM_Allocator_CrossThreadFree(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int InFlightNum = state.range(1);
+    AllocatorType Allocator;
+    for (auto _ : state)
+    {
+        IESPSCQueue<ElementType*> Queue(InFlightNum);
+        std::atomic<bool> bStart{ false };
+        std::thread Consumer([&]
+        {
+            AllocatorType ConsumerAllocator(Allocator);
+            while (!bStart.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < N; i++)
+            {
+                ElementType* Element = nullptr;
+                while (!Queue.Pop(Element)) {}
+                std::allocator_traits<AllocatorType>::destroy(ConsumerAllocator, Element);
+                std::allocator_traits<AllocatorType>::deallocate(ConsumerAllocator, Element, 1);
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (int i = 0; i < N; i++)
+        {
+            ElementType* Element = std::allocator_traits<AllocatorType>::allocate(Allocator, 1);
+            std::allocator_traits<AllocatorType>::construct(Allocator, Element);
+            while (!Queue.Push(Element)) {}
+        }
+        Consumer.join();
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+// Every write of a heap IESpinOnWriteObject allocates the new version and frees the previous one, one object at a time.
+template<typename ElementType, typename AllocatorType>
+static void BM_Allocator_SpinOnWriteObjectWrite(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject{};
+    IESpinOnWriteObject<ElementType, IESpinOnWriteStorage::Heap, AllocatorType> Object(NewObject);
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            Object.Write(NewObject);
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename AllocatorType>
+static AllocatorType MakeAllocator(bool bPrefault)
+{
+    if constexpr (std::is_same_v<AllocatorType, IEHugePageAllocator<typename AllocatorType::value_type>>)
+    {
+        return AllocatorType(AllocatorType::AnyNumaNode, bPrefault);
+    }
+    else
+    {
+        return AllocatorType();
+    }
+}
+
+template<typename ElementType, typename AllocatorType>
+static void BM_IESPSCQueue_FirstPass(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const bool bPrefault = state.range(1);
+    double ConstructionTime = 0.0;
+    for (auto _ : state)
+    {
+        auto ConstructionStart = std::chrono::high_resolution_clock::now();
+        IESPSCQueue<ElementType, AllocatorType> Queue(N, MakeAllocator<AllocatorType>(bPrefault));
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            benchmark::DoNotOptimize(Queue.Push(ElementType()));
+        }
+        ElementType Element;
+        for (int i = 0; i < N; i++)
+        {
+            benchmark::DoNotOptimize(Queue.Pop(Element));
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        ConstructionTime += std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(Start - ConstructionStart).count();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+    state.counters["ConstructionUs"] = benchmark::Counter(ConstructionTime / state.iterations());
+}
+
+template<typename ElementType, typename AllocatorType>
+static void BM_IESPSCQueue_SteadyState(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    IESPSCQueue<ElementType, AllocatorType> Queue(N);
+    ElementType Element;
+    for (int i = 0; i < N; i++)
+    {
+        Queue.Push(ElementType());
+    }
+    while (Queue.Pop(Element)) {}
+
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++)
+        {
+            benchmark::DoNotOptimize(Queue.Push(ElementType()));
+        }
+        for (int i = 0; i < N; i++)
+        {
+            benchmark::DoNotOptimize(Queue.Pop(Element));
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+#if defined(__linux__)
+template<typename ElementType>
+static void BM_IESharedMemorySPSCQueue_CrossProcessLatency(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    std::optional<IESharedMemorySPSCQueue<ElementType>> Queue1 = IESharedMemorySPSCQueue<ElementType>::CreateAnonymous(N);
+    std::optional<IESharedMemorySPSCQueue<ElementType>> Queue2 = IESharedMemorySPSCQueue<ElementType>::CreateAnonymous(N);
+    if (!Queue1 || !Queue2)
+    {
+        state.SkipWithError("Failed to create the shared memory queues.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        const pid_t ChildProcess = fork();
+        if (ChildProcess == 0)
+        {
+            for (int i = 0; i < N; i++)
+            {
+                ElementType Element;
+                while (!Queue1->Pop(Element)) {}
+                while (!Queue2->Push(Element)) {}
+            }
+            _exit(0);
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < N; i++)
+        {
+            while (!Queue1->Push(ElementType())) {}
+            ElementType Element;
+            benchmark::DoNotOptimize(Element);
+            while (!Queue2->Pop(Element)) {}
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        waitpid(ChildProcess, nullptr, 0);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_SocketPair_CrossProcessLatency(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    int Sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, Sockets) != 0)
+    {
+        state.SkipWithError("Failed to create the socket pair.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        const pid_t ChildProcess = fork();
+        if (ChildProcess == 0)
+        {
+            for (int i = 0; i < N; i++)
+            {
+                ElementType Element;
+                if (read(Sockets[1], &Element, sizeof(Element)) != sizeof(Element) || write(Sockets[1], &Element, sizeof(Element)) != sizeof(Element))
+                {
+                    _exit(1);
+                }
+            }
+            _exit(0);
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (int i = 0; i < N; i++)
+        {
+            ElementType Element{};
+            benchmark::DoNotOptimize(write(Sockets[0], &Element, sizeof(Element)));
+            benchmark::DoNotOptimize(read(Sockets[0], &Element, sizeof(Element)));
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        waitpid(ChildProcess, nullptr, 0);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+
+    close(Sockets[0]);
+    close(Sockets[1]);
+}
+#endif
+
+// Message sizes mixing mostly small control messages with some medium payloads and a few large blobs up to MaxSize bytes.
+static inline std::vector<uint32_t> GenerateMessageSizes(size_t N, size_t MaxSize)
+{
+    std::mt19937 RandomGenerator(42);
+    std::uniform_int_distribution<uint32_t> Percentile(0, 99);
+    std::uniform_int_distribution<uint32_t> SmallSize(8, 63), MediumSize(64, 1023), LargeSize(1024, static_cast<uint32_t>(MaxSize));
+    std::vector<uint32_t> MessageSizes(N);
+    for (uint32_t& MessageSize : MessageSizes)
+    {
+        const uint32_t MessagePercentile = Percentile(RandomGenerator);
+        MessageSize = MessagePercentile < 70 ? SmallSize(RandomGenerator) : MessagePercentile < 95 ? MediumSize(RandomGenerator) : LargeSize(RandomGenerator);
+    }
+    return MessageSizes;
+}
+
+template<typename PushFunction, typename PopFunction>
+static void RunMixedSizesThroughput(benchmark::State& state, const std::vector<uint32_t>& MessageSizes, PushFunction Push, PopFunction Pop)
+{
+    const size_t N = MessageSizes.size();
+    size_t BytesNum = 0;
+    for (uint32_t MessageSize : MessageSizes)
+    {
+        BytesNum += MessageSize;
+    }
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::thread Producer([&]
+        {
+            while (!bStart.load(std::memory_order_acquire)) {}
+            for (size_t i = 0; i < N; i++)
+            {
+                while (!Push(MessageSizes[i])) {}
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (size_t i = 0; i < N; i++)
+        {
+            while (!Pop()) {}
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        Producer.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+    state.SetBytesProcessed(BytesNum * state.iterations());
+}
+
+static inline void RunByteRingBufferThroughput(benchmark::State& state, IEByteRingBuffer<>& RingBuffer, const std::vector<uint32_t>& MessageSizes, size_t MaxMessageSize)
+{
+    std::vector<std::byte> Source(MaxMessageSize), Destination(MaxMessageSize);
+    RunMixedSizesThroughput(state, MessageSizes,
+        [&](uint32_t MessageSize)
+        {
+            std::optional<std::span<std::byte>> Record = RingBuffer.Reserve(MessageSize);
+            if (!Record)
+            {
+                return false;
+            }
+            std::memcpy(Record->data(), Source.data(), MessageSize);
+            RingBuffer.Commit(MessageSize);
+            return true;
+        },
+        [&]
+        {
+            std::optional<std::span<const std::byte>> Record = RingBuffer.Read();
+            if (!Record)
+            {
+                return false;
+            }
+            std::memcpy(Destination.data(), Record->data(), Record->size());
+            RingBuffer.Release();
+            return true;
+        });
+}
+
+template<size_t MaxMessageSize>
+static void BM_IEByteRingBuffer_MixedSizes(benchmark::State& state)
+{
+    const std::vector<uint32_t> MessageSizes = GenerateMessageSizes(state.range(0), MaxMessageSize);
+    IEByteRingBuffer<> RingBuffer(state.range(1));
+    RunByteRingBufferThroughput(state, RingBuffer, MessageSizes, MaxMessageSize);
+}
+
+// Alternates 8 byte records with records of the largest size, so the large records keep landing across the end of the ring.
+static inline void BM_IEByteRingBuffer_LargestRecords(benchmark::State& state)
+{
+    IEByteRingBuffer<> RingBuffer(state.range(1));
+    const uint32_t MaxRecordSize = static_cast<uint32_t>(RingBuffer.GetMaxRecordSize());
+    std::vector<uint32_t> MessageSizes(state.range(0));
+    for (size_t i = 0; i < MessageSizes.size(); i++)
+    {
+        MessageSizes[i] = i % 2 ? MaxRecordSize : 8;
+    }
+    RunByteRingBufferThroughput(state, RingBuffer, MessageSizes, MaxRecordSize);
+}
+
+template<size_t MaxMessageSize>
+static void BM_IESPSCQueue_HeapMessages(benchmark::State& state)
+{
+    const std::vector<uint32_t> MessageSizes = GenerateMessageSizes(state.range(0), MaxMessageSize);
+    IESPSCQueue<std::vector<std::byte>> Queue(state.range(1) / MaxMessageSize);
+    std::vector<std::byte> Source(MaxMessageSize), Destination(MaxMessageSize);
+    RunMixedSizesThroughput(state, MessageSizes,
+        [&](uint32_t MessageSize)
+        {
+            return Queue.Push(Source.begin(), Source.begin() + MessageSize);
+        },
+        [&]
+        {
+            std::vector<std::byte> Message;
+            if (!Queue.Pop(Message))
+            {
+                return false;
+            }
+            std::memcpy(Destination.data(), Message.data(), Message.size());
+            return true;
+        });
+}
+
+template<size_t MaxMessageSize>
+static void BM_IESPSCQueue_MaxSizeMessages(benchmark::State& state)
+{
+    struct Message
+    {
+        uint32_t Size;
+        std::byte Payload[MaxMessageSize];
+    };
+
+    const std::vector<uint32_t> MessageSizes = GenerateMessageSizes(state.range(0), MaxMessageSize);
+    IESPSCQueue<Message> Queue(state.range(1) / sizeof(Message));
+    std::vector<std::byte> Source(MaxMessageSize), Destination(MaxMessageSize);
+    RunMixedSizesThroughput(state, MessageSizes,
+        [&](uint32_t MessageSize)
+        {
+            std::span<Message> Slot = Queue.ReserveWrite(1);
+            if (Slot.empty())
+            {
+                return false;
+            }
+            Slot[0].Size = MessageSize;
+            std::memcpy(Slot[0].Payload, Source.data(), MessageSize);
+            Queue.CommitWrite(1);
+            return true;
+        },
+        [&]
+        {
+            std::span<const Message> Slot = Queue.ReserveRead(1);
+            if (Slot.empty())
+            {
+                return false;
+            }
+            std::memcpy(Destination.data(), Slot[0].Payload, Slot[0].Size);
+            Queue.CommitRead(1);
+            return true;
+        });
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_Throughput(benchmark::State& state)
+{
+    IESPMCQueue<ElementType> Queue(state.range(0));
+    RunMPMCThroughput<ElementType>(state, Queue,
+        [](IESPMCQueue<ElementType>& Queue) { return Queue.Push(ElementType()); },
+        [](IESPMCQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); });
+}
+
+template<typename ElementType>
+static void BM_BoostQueue_SPMCThroughput(benchmark::State& state)
+{
+    boost::lockfree::queue<ElementType> Queue(state.range(0));
+    RunMPMCThroughput<ElementType>(state, Queue,
+        [](boost::lockfree::queue<ElementType>& Queue) { return Queue.bounded_push(ElementType()); },
+        [](boost::lockfree::queue<ElementType>& Queue, ElementType& Element) { return Queue.pop(Element); });
+}
+
+template<typename ElementType>
+struct MutexQueue
+{
+    bool Push(const ElementType& Element)
+    {
+        std::lock_guard Lock(Mutex);
+        Elements.push_back(Element);
+        return true;
+    }
+
+    bool Pop(ElementType& Element)
+    {
+        std::lock_guard Lock(Mutex);
+        if (Elements.empty())
+        {
+            return false;
+        }
+        Element = Elements.front();
+        Elements.pop_front();
+        return true;
+    }
+
+    std::mutex Mutex;
+    std::deque<ElementType> Elements;
+};
+
+template<typename ElementType>
+static void BM_MutexQueue_SPMCThroughput(benchmark::State& state)
+{
+    MutexQueue<ElementType> Queue;
+    RunMPMCThroughput<ElementType>(state, Queue,
+        [](MutexQueue<ElementType>& Queue) { return Queue.Push(ElementType()); },
+        [](MutexQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); });
+}
+
+/*
+    Round trips from one producer through competing consumers: the producer pushes one element at a time,
+    whichever consumer pops it sends it back through ReplyQueue.
+*/
+template<typename ElementType, typename QueueType, typename ReplyQueueType, typename PushFunction, typename PopFunction, typename ReplyPushFunction, typename ReplyPopFunction>
+static void RunSPMCLatency(benchmark::State& state, QueueType& Queue, ReplyQueueType& ReplyQueue, PushFunction Push, PopFunction Pop, ReplyPushFunction ReplyPush, ReplyPopFunction ReplyPop)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int ConsumersNum = state.range(1);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bHasFinished{ false };
+        std::vector<std::thread> Consumers;
+        for (unsigned int c = 0; c < ConsumersNum; c++)
+        {
+            Consumers.emplace_back([&]
+            {
+                ElementType Element{};
+                benchmark::DoNotOptimize(Element);
+                while (!bHasFinished.load(std::memory_order_relaxed))
+                {
+                    if (Pop(Queue, Element))
+                    {
+                        while (!ReplyPush(ReplyQueue, Element)) {}
+                    }
+                }
+            });
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int i = 0; i < N; i++)
+        {
+            while (!Push(Queue, ElementType())) {}
+            ElementType Element{};
+            benchmark::DoNotOptimize(Element);
+            while (!ReplyPop(ReplyQueue, Element)) {}
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        bHasFinished.store(true, std::memory_order_relaxed);
+        for (std::thread& Consumer : Consumers)
+        {
+            Consumer.join();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_Latency(benchmark::State& state)
+{
+    IESPMCQueue<ElementType> Queue(state.range(0));
+    IEMPSCQueue<ElementType> ReplyQueue(state.range(0));
+    RunSPMCLatency<ElementType>(state, Queue, ReplyQueue,
+        [](IESPMCQueue<ElementType>& Queue, const ElementType& Element) { return Queue.Push(Element); },
+        [](IESPMCQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); },
+        [](IEMPSCQueue<ElementType>& Queue, const ElementType& Element) { return Queue.Push(Element); },
+        [](IEMPSCQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); });
+}
+
+template<typename ElementType>
+static void BM_BoostQueue_SPMCLatency(benchmark::State& state)
+{
+    boost::lockfree::queue<ElementType> Queue(state.range(0)), ReplyQueue(state.range(0));
+    RunSPMCLatency<ElementType>(state, Queue, ReplyQueue,
+        [](boost::lockfree::queue<ElementType>& Queue, const ElementType& Element) { return Queue.bounded_push(Element); },
+        [](boost::lockfree::queue<ElementType>& Queue, ElementType& Element) { return Queue.pop(Element); },
+        [](boost::lockfree::queue<ElementType>& Queue, const ElementType& Element) { return Queue.bounded_push(Element); },
+        [](boost::lockfree::queue<ElementType>& Queue, ElementType& Element) { return Queue.pop(Element); });
+}
+
+template<typename ElementType>
+static void BM_MutexQueue_SPMCLatency(benchmark::State& state)
+{
+    MutexQueue<ElementType> Queue, ReplyQueue;
+    RunSPMCLatency<ElementType>(state, Queue, ReplyQueue,
+        [](MutexQueue<ElementType>& Queue, const ElementType& Element) { return Queue.Push(Element); },
+        [](MutexQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); },
+        [](MutexQueue<ElementType>& Queue, const ElementType& Element) { return Queue.Push(Element); },
+        [](MutexQueue<ElementType>& Queue, ElementType& Element) { return Queue.Pop(Element); });
+}
+
+template<typename ElementType>
+static void BM_MutexObject_Write(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject(state.range(1));
+    ElementType Object(NewObject);
+    std::mutex Mutex;
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (unsigned int i = 0; i < N; i++)
+        {
+            std::lock_guard Lock(Mutex);
+            Object = NewObject;
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType, typename MutexType>
+static void BM_MutexObject_ReadLatency(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    const ElementType NewObject(state.range(1));
+    ElementType Object(NewObject);
+    MutexType Mutex;
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bHasFinished{ false };
+        std::thread Writer([&]
+        {
+            while (!bHasFinished.load(std::memory_order_relaxed))
+            {
+                std::unique_lock Lock(Mutex);
+                Object = NewObject;
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int i = 0; i < N; i++)
+        {
+            if constexpr (std::is_same_v<MutexType, std::shared_mutex>)
+            {
+                std::shared_lock Lock(Mutex);
+                benchmark::DoNotOptimize(Object.data());
+            }
+            else
+            {
+                std::lock_guard Lock(Mutex);
+                benchmark::DoNotOptimize(Object.data());
+            }
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        bHasFinished.store(true, std::memory_order_relaxed);
+        Writer.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+// Fixed capacity queues take no size and store their ring inline, so both kinds are created on the heap the same way.
+template<typename QueueType>
+static std::unique_ptr<QueueType> MakeQueue(size_t Size)
+{
+    if constexpr (std::is_constructible_v<QueueType, size_t>)
+    {
+        return std::make_unique<QueueType>(Size);
+    }
+    else
+    {
+        return std::make_unique<QueueType>();
+    }
+}
+
+template<typename ElementType, typename QueueType>
+static void RunStreaming(benchmark::State& state, QueueType& Queue)
+{
+    const unsigned int N = state.range(0);
+
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            for (unsigned int i = 0; i < N; i++)
+            {
+                while (!Queue.Push(ElementType())) {}
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int i = 0; i < N; i++)
+        {
+            ElementType Element{};
+            while (!Queue.Pop(Element)) {}
+            benchmark::DoNotOptimize(Element);
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        Thread.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType, typename QueueType = IESPSCQueue<ElementType>>
+static void BM_IESPSCQueue_Streaming(benchmark::State& state)
+{
+    std::unique_ptr<QueueType> Queue = MakeQueue<QueueType>(state.range(1));
+    RunStreaming<ElementType>(state, *Queue);
+}
+
+template<typename ElementType, typename QueueType = IESPMCQueue<ElementType>>
+static void BM_IESPMCQueue_BoundedThroughput(benchmark::State& state)
+{
+    std::unique_ptr<QueueType> Queue = MakeQueue<QueueType>(state.range(3));
+    RunMPMCThroughput<ElementType>(state, *Queue,
+        [](QueueType& Queue) { return Queue.Push(ElementType()); },
+        [](QueueType& Queue, ElementType& Element) { return Queue.Pop(Element); });
+}
+
+/*
+    Delivers N elements from one producer to every one of range(1) subscribers,
+    each subscriber stopping once it has received or been reported as having dropped all N elements.
+    GetDroppedNum returns a subscriber's running total of dropped elements.
+*/
+template<typename ElementType, typename PushFunction, typename PopFunction, typename DroppedNumFunction>
+static void RunFanOut(benchmark::State& state, PushFunction Push, PopFunction Pop, DroppedNumFunction GetDroppedNum)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int SubscribersNum = state.range(1);
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::vector<std::thread> Subscribers;
+        for (unsigned int s = 0; s < SubscribersNum; s++)
+        {
+            Subscribers.emplace_back([&, s]
+            {
+                const size_t InitialDroppedNum = GetDroppedNum(s);
+                while (!bStart.load(std::memory_order_acquire)) {}
+                size_t ReceivedNum = 0;
+                while (ReceivedNum + GetDroppedNum(s) - InitialDroppedNum < N)
+                {
+                    ElementType Element{};
+                    if (Pop(s, Element))
+                    {
+                        benchmark::DoNotOptimize(Element);
+                        ReceivedNum++;
+                    }
+                }
+            });
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        for (unsigned int i = 0; i < N; i++)
+        {
+            Push(ElementType());
+        }
+        for (std::thread& Subscriber : Subscribers)
+        {
+            Subscriber.join();
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+
+    size_t TotalDroppedNum = 0;
+    for (unsigned int s = 0; s < SubscribersNum; s++)
+    {
+        TotalDroppedNum += GetDroppedNum(s);
+    }
+    state.SetItemsProcessed(N * state.iterations());
+    state.SetBytesProcessed(N * sizeof(ElementType) * state.iterations());
+    state.counters["DroppedPerSubscriber"] = static_cast<double>(TotalDroppedNum) / (SubscribersNum * state.iterations());
+}
+
+template<typename ElementType, IEBroadcastMode Mode>
+static void BM_IEBroadcastRing_FanOut(benchmark::State& state)
+{
+    IEBroadcastRing<ElementType, Mode> Ring(state.range(2), state.range(1));
+    RunFanOut<ElementType>(state,
+        [&](const ElementType& Element)
+        {
+            while (!Ring.Push(Element)) {}
+        },
+        [&](size_t SubscriberIndex, ElementType& Element) { return Ring.Pop(SubscriberIndex, Element); },
+        [&](size_t SubscriberIndex) { return Ring.GetDroppedNum(SubscriberIndex); });
+}
+
+template<typename ElementType>
+static void BM_IESPSCQueue_FanOut(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<IESPSCQueue<ElementType>>> Queues;
+    for (int64_t s = 0; s < state.range(1); s++)
+    {
+        Queues.push_back(std::make_unique<IESPSCQueue<ElementType>>(state.range(2)));
+    }
+    RunFanOut<ElementType>(state,
+        [&](const ElementType& Element)
+        {
+            for (std::unique_ptr<IESPSCQueue<ElementType>>& Queue : Queues)
+            {
+                while (!Queue->Push(Element)) {}
+            }
+        },
+        [&](size_t SubscriberIndex, ElementType& Element) { return Queues[SubscriberIndex]->Pop(Element); },
+        [](size_t) { return size_t(0); });
+}
+
+
+// Sends N elements through PingQueue and waits for each reply on PongQueue before sending the next one.
+template<typename QueueType>
+static IECoroutineExecutor::DetachedCoroutine PingCoroutine(QueueType& PingQueue, QueueType& PongQueue, IECoroutineExecutor& Executor, unsigned int N)
+{
+    using ElementType = typename QueueType::ValueType;
+    for (unsigned int i = 0; i < N; i++)
+    {
+        co_await PingQueue.PushAsync(ElementType(), Executor);
+        ElementType Element = co_await PongQueue.PopAsync(Executor);
+        benchmark::DoNotOptimize(Element);
+    }
+    Executor.Stop();
+}
+
+template<typename QueueType>
+static IECoroutineExecutor::DetachedCoroutine PongCoroutine(QueueType& PingQueue, QueueType& PongQueue, IECoroutineExecutor& Executor, unsigned int N)
+{
+    for (unsigned int i = 0; i < N; i++)
+    {
+        co_await PongQueue.PushAsync(co_await PingQueue.PopAsync(Executor), Executor);
+    }
+}
+
+// Both coroutines run on the same executor, so every round trip suspends and resumes twice without switching threads.
+template<typename ElementType, typename QueueType>
+static void RunCoroutineHandoff(benchmark::State& state)
+{
+    const unsigned int N = state.range(0);
+    QueueType PingQueue(1), PongQueue(1);
+    IECoroutineExecutor Executor;
+
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        PongCoroutine(PingQueue, PongQueue, Executor, N);
+        PingCoroutine(PingQueue, PongQueue, Executor, N);
+        Executor.Run();
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IESPSCQueue_CoroutineHandoff(benchmark::State& state)
+{
+    RunCoroutineHandoff<ElementType, IESPSCQueue<ElementType>>(state);
+}
+
+template<typename ElementType>
+static void BM_IESPMCQueue_CoroutineHandoff(benchmark::State& state)
+{
+    RunCoroutineHandoff<ElementType, IESPMCQueue<ElementType>>(state);
+}
+
+
+/*
+    Each round pushes ActiveNum elements to queues picked at random among QueuesNum, as sparse producers would,
+    then drains them all before the next round, so the time per element shows how much draining costs with mostly empty queues.
+*/
+template<typename ElementType, typename PushFunction, typename DrainFunction>
+static void RunSparseFanIn(benchmark::State& state, PushFunction Push, DrainFunction Drain)
+{
+    const size_t N = state.range(0);
+    const size_t QueuesNum = state.range(1);
+    const size_t ActiveNum = state.range(2);
+    const size_t RoundsNum = N / ActiveNum;
+
+    for (auto _ : state)
+    {
+        uint32_t RandomState = 2463534242u;
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (size_t Round = 0; Round < RoundsNum; Round++)
+        {
+            for (size_t i = 0; i < ActiveNum; i++)
+            {
+                RandomState ^= RandomState << 13;
+                RandomState ^= RandomState >> 17;
+                RandomState ^= RandomState << 5;
+                Push(RandomState % QueuesNum, ElementType());
+            }
+            size_t PoppedNum = 0;
+            while (PoppedNum < ActiveNum)
+            {
+                PoppedNum += Drain();
+            }
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(RoundsNum * ActiveNum * state.iterations());
+}
+
+template<typename ElementType>
+static void BM_IEQueueSelector_SparseFanIn(benchmark::State& state)
+{
+    IEQueueSelector<ElementType> Selector(state.range(1), state.range(3));
+    RunSparseFanIn<ElementType>(state,
+        [&](size_t QueueIndex, const ElementType& Element) { Selector.Push(QueueIndex, Element); },
+        [&]() { return Selector.Drain([](size_t, ElementType& Element) { benchmark::DoNotOptimize(Element); }); });
+}
+
+// Round-robin polling of every queue, popping at most as many elements per visit as IEQueueSelector's default quota.
+template<typename ElementType>
+static void BM_PollingQueues_SparseFanIn(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<IESPSCQueue<ElementType>>> Queues;
+    for (int64_t q = 0; q < state.range(1); q++)
+    {
+        Queues.push_back(std::make_unique<IESPSCQueue<ElementType>>(state.range(3)));
+    }
+    RunSparseFanIn<ElementType>(state,
+        [&](size_t QueueIndex, const ElementType& Element) { Queues[QueueIndex]->Push(Element); },
+        [&]()
+        {
+            size_t PoppedNum = 0;
+            ElementType Element;
+            for (std::unique_ptr<IESPSCQueue<ElementType>>& Queue : Queues)
+            {
+                for (size_t i = 0; i < 32 && Queue->Pop(Element); i++)
+                {
+                    benchmark::DoNotOptimize(Element);
+                    PoppedNum++;
+                }
+            }
+            return PoppedNum;
+        });
+}
+
+/*
+    Producer threads each own an equal slice of the queues and push to random queues of their slice,
+    waiting range(4) nanoseconds between pushes so that most queues stay empty. The consumer drains until it has every element.
+    The DrainPasses counter reports how many drain calls the consumer made per element.
+*/
+template<typename ElementType, typename PushFunction, typename DrainFunction>
+static void RunThreadedSparseFanIn(benchmark::State& state, PushFunction Push, DrainFunction Drain)
+{
+    const size_t QueuesNum = state.range(1);
+    const size_t ProducersNum = state.range(2);
+    const size_t ElementsPerProducer = state.range(0) / ProducersNum;
+    const size_t QueuesPerProducer = QueuesNum / ProducersNum;
+    const std::chrono::nanoseconds PushInterval(state.range(4));
+    size_t DrainPassesNum = 0;
+
+    for (auto _ : state)
+    {
+        std::atomic<bool> bStart{ false };
+        std::vector<std::thread> Producers;
+        for (size_t p = 0; p < ProducersNum; p++)
+        {
+            Producers.emplace_back([&, p]
+            {
+                uint32_t RandomState = 2463534242u + static_cast<uint32_t>(p);
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (size_t i = 0; i < ElementsPerProducer; i++)
+                {
+                    const std::chrono::steady_clock::time_point NextPushTime = std::chrono::steady_clock::now() + PushInterval;
+                    RandomState ^= RandomState << 13;
+                    RandomState ^= RandomState >> 17;
+                    RandomState ^= RandomState << 5;
+                    while (!Push(p * QueuesPerProducer + RandomState % QueuesPerProducer, ElementType())) {}
+                    while (std::chrono::steady_clock::now() < NextPushTime) {}
+                }
+            });
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        bStart.store(true, std::memory_order_release);
+
+        size_t PoppedNum = 0;
+        while (PoppedNum < ElementsPerProducer * ProducersNum)
+        {
+            PoppedNum += Drain();
+            DrainPassesNum++;
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        for (std::thread& Producer : Producers)
+        {
+            Producer.join();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(ElementsPerProducer * ProducersNum * state.iterations());
+    state.counters["DrainPasses"] = static_cast<double>(DrainPassesNum) / (ElementsPerProducer * ProducersNum * state.iterations());
+}
+
+// The consumer parks in DrainWait while every queue is empty.
+template<typename ElementType>
+static void BM_IEQueueSelector_ThreadedSparseFanIn(benchmark::State& state)
+{
+    IEQueueSelector<ElementType> Selector(state.range(1), state.range(3));
+    RunThreadedSparseFanIn<ElementType>(state,
+        [&](size_t QueueIndex, const ElementType& Element) { return Selector.Push(QueueIndex, Element); },
+        [&]() { return Selector.DrainWait([](size_t, ElementType& Element) { benchmark::DoNotOptimize(Element); }); });
+}
+
+// The consumer keeps polling every queue, with the same per-visit quota as IEQueueSelector.
+template<typename ElementType>
+static void BM_PollingQueues_ThreadedSparseFanIn(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<IESPSCQueue<ElementType>>> Queues;
+    for (int64_t q = 0; q < state.range(1); q++)
+    {
+        Queues.push_back(std::make_unique<IESPSCQueue<ElementType>>(state.range(3)));
+    }
+    RunThreadedSparseFanIn<ElementType>(state,
+        [&](size_t QueueIndex, const ElementType& Element) { return Queues[QueueIndex]->Push(Element); },
+        [&]()
+        {
+            size_t PoppedNum = 0;
+            ElementType Element;
+            for (std::unique_ptr<IESPSCQueue<ElementType>>& Queue : Queues)
+            {
+                for (size_t i = 0; i < 32 && Queue->Pop(Element); i++)
+                {
+                    benchmark::DoNotOptimize(Element);
+                    PoppedNum++;
+                }
+            }
+            return PoppedNum;
+        });
+}
+
+
+// Per-thread xorshift so that concurrent readers look up independent random keys.
+static inline size_t NextRandomKey(size_t KeysNum)
+{
+    thread_local uint32_t RandomState = 2463534242u ^ static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return RandomState % KeysNum;
+}
+
+template<typename KeyType, typename ValueType>
+static void BM_IEConcurrentHashMap_ConcurrentLookups(benchmark::State& state)
+{
+    const size_t KeysNum = state.range(3);
+    IEConcurrentHashMap<KeyType, ValueType> Map(KeysNum);
+    for (size_t k = 0; k < KeysNum; k++)
+    {
+        Map.InsertOrAssign(KeyType(k), ValueType());
+    }
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            Map.Visit(KeyType(NextRandomKey(KeysNum)), [](const ValueType& Value) { benchmark::DoNotOptimize(Value); });
+        },
+        [&](unsigned int i) { Map.InsertOrAssign(KeyType(i % KeysNum), ValueType(i)); });
+}
+
+// The single reader locks the whole map, the writer copies it on every update.
+template<typename KeyType, typename ValueType>
+static void BM_SpinOnWriteMap_ConcurrentLookups(benchmark::State& state)
+{
+    const size_t KeysNum = state.range(3);
+    std::unordered_map<KeyType, ValueType> InitialMap;
+    for (size_t k = 0; k < KeysNum; k++)
+    {
+        InitialMap.emplace(KeyType(k), ValueType());
+    }
+    IESpinOnWriteObject<std::unordered_map<KeyType, ValueType>> Map(InitialMap);
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            const auto LockedMap = Map.LockForRead();
+            benchmark::DoNotOptimize(LockedMap.Value.find(KeyType(NextRandomKey(KeysNum)))->second);
+        },
+        [&](unsigned int i) { Map.Modify([&](std::unordered_map<KeyType, ValueType>& NewMap) { NewMap[KeyType(i % KeysNum)] = ValueType(i); }); });
+}
+
+template<typename KeyType, typename ValueType>
+static void BM_SharedMutexMap_ConcurrentLookups(benchmark::State& state)
+{
+    const size_t KeysNum = state.range(3);
+    std::unordered_map<KeyType, ValueType> Map;
+    for (size_t k = 0; k < KeysNum; k++)
+    {
+        Map.emplace(KeyType(k), ValueType());
+    }
+    std::shared_mutex Mutex;
+    RunConcurrentReadersWithWriter(state,
+        [&]
+        {
+            std::shared_lock Lock(Mutex);
+            benchmark::DoNotOptimize(Map.find(KeyType(NextRandomKey(KeysNum)))->second);
+        },
+        [&](unsigned int i)
+        {
+            std::unique_lock Lock(Mutex);
+            Map[KeyType(i % KeysNum)] = ValueType(i);
+        });
+}
+
+// Measures N updates of existing keys on a single thread, with range(1) keys in the map.
+template<typename MapType, typename UpdateFunction>
+static void RunMapUpdates(benchmark::State& state, MapType& Map, UpdateFunction Update)
+{
+    const unsigned int N = state.range(0);
+    const size_t KeysNum = state.range(1);
+    for (auto _ : state)
+    {
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (unsigned int i = 0; i < N; i++)
+        {
+            Update(Map, i % KeysNum, i);
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(N * state.iterations());
+}
+
+template<typename KeyType, typename ValueType>
+static void BM_IEConcurrentHashMap_Update(benchmark::State& state)
+{
+    IEConcurrentHashMap<KeyType, ValueType> Map(state.range(1));
+    for (int64_t k = 0; k < state.range(1); k++)
+    {
+        Map.InsertOrAssign(KeyType(k), ValueType());
+    }
+    RunMapUpdates(state, Map,
+        [](IEConcurrentHashMap<KeyType, ValueType>& Map, size_t Key, unsigned int i) { Map.InsertOrAssign(KeyType(Key), ValueType(i)); });
+}
+
+template<typename KeyType, typename ValueType>
+static void BM_SpinOnWriteMap_Update(benchmark::State& state)
+{
+    std::unordered_map<KeyType, ValueType> InitialMap;
+    for (int64_t k = 0; k < state.range(1); k++)
+    {
+        InitialMap.emplace(KeyType(k), ValueType());
+    }
+    IESpinOnWriteObject<std::unordered_map<KeyType, ValueType>> Map(InitialMap);
+    RunMapUpdates(state, Map,
+        [](IESpinOnWriteObject<std::unordered_map<KeyType, ValueType>>& Map, size_t Key, unsigned int i)
+        {
+            Map.Modify([&](std::unordered_map<KeyType, ValueType>& NewMap) { NewMap[KeyType(Key)] = ValueType(i); });
+        });
+}
+
+template<typename KeyType, typename ValueType>
+static void BM_SharedMutexMap_Update(benchmark::State& state)
+{
+    std::unordered_map<KeyType, ValueType> Map;
+    for (int64_t k = 0; k < state.range(1); k++)
+    {
+        Map.emplace(KeyType(k), ValueType());
+    }
+    std::shared_mutex Mutex;
+    RunMapUpdates(state, Map,
+        [&](std::unordered_map<KeyType, ValueType>& Map, size_t Key, unsigned int i)
+        {
+            std::unique_lock Lock(Mutex);
+            Map[KeyType(Key)] = ValueType(i);
+        });
+}
+
+
+template<typename ElementType>
+static void BM_IEUnboundedSPSCQueue_Streaming(benchmark::State& state)
+{
+    IEUnboundedSPSCQueue<ElementType> Queue;
+    RunStreaming<ElementType>(state, Queue);
+}
+
+/*
+    The producer pushes N elements in bursts of range(1) elements and waits for the consumer to drain each burst before the next one.
+    The BurstPushNs counter reports the average time the producer took to push a whole burst,
+    which grows when a bounded queue fills up and the producer has to wait for the consumer.
+*/
+template<typename ElementType, typename QueueType>
+static void RunBursts(benchmark::State& state, QueueType& Queue)
+{
+    const unsigned int N = state.range(0);
+    const unsigned int BurstSize = state.range(1);
+    const unsigned int BurstsNum = N / BurstSize;
+    std::chrono::steady_clock::duration TotalBurstPushTime{ 0 };
+
+    for (auto _ : state)
+    {
+        std::thread Thread = std::thread([&]
+        {
+            for (unsigned int Burst = 0; Burst < BurstsNum; Burst++)
+            {
+                const std::chrono::steady_clock::time_point BurstStart = std::chrono::steady_clock::now();
+                for (unsigned int i = 0; i < BurstSize; i++)
+                {
+                    while (!Queue.Push(ElementType())) {}
+                }
+                TotalBurstPushTime += std::chrono::steady_clock::now() - BurstStart;
+                while (!Queue.IsEmpty()) {}
+            }
+        });
+
+        auto Start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int i = 0; i < BurstsNum * BurstSize; i++)
+        {
+            ElementType Element{};
+            while (!Queue.Pop(Element)) {}
+            benchmark::DoNotOptimize(Element);
+        }
+
+        auto End = std::chrono::high_resolution_clock::now();
+        auto Elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(End - Start);
+        state.SetIterationTime(Elapsed.count());
+
+        Thread.join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(BurstsNum * BurstSize * state.iterations());
+    state.counters["BurstPushNs"] = std::chrono::duration<double, std::nano>(TotalBurstPushTime).count() / (BurstsNum * state.iterations());
+}
+
+// range(2) is the queue size, which is smaller than the burst when the queue is not sized for the worst case.
+template<typename ElementType>
+static void BM_IESPSCQueue_Bursts(benchmark::State& state)
+{
+    IESPSCQueue<ElementType> Queue(state.range(2));
+    RunBursts<ElementType>(state, Queue);
+}
+
+template<typename ElementType>
+static void BM_IEUnboundedSPSCQueue_Bursts(benchmark::State& state)
+{
+    IEUnboundedSPSCQueue<ElementType> Queue;
+    RunBursts<ElementType>(state, Queue);
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- MPMCQueueBenchmark -------------------------- */
+
+// Set the size and type of elements to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 20;
+using ElementTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// SCALING_THROUGHPUT_BENCHMARK: Measures throughput over a grid of producer and consumer thread counts.
+#define SCALING_THROUGHPUT_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to move N elements from the producer threads to the consumer threads,
+    where N is defined by the constant ELEMENT_TEST_SIZE, for every combination of 1 to 8 producers and 1 to 8 consumers.
+
+    The test uses manual timing from releasing all threads until every consumer has popped its share of the N elements.
+    Along with the total throughput, the ItemsPerThread counter reports the throughput per participating core.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if SCALING_THROUGHPUT_BENCHMARK
+#define ARGS_B1 ArgsProduct({ { ELEMENT_TEST_SIZE }, { 1, 2, 4, 8 }, { 1, 2, 4, 8 } })->ArgNames({ "N", "Producers", "Consumers" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEMPMCQueue_Throughput,       ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_BoostQueue_MPMCThroughput,    ElementTestType)->ARGS_B1;
+#endif
+
+BENCHMARK_MAIN();
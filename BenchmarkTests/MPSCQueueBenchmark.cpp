@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- MPSCQueueBenchmark -------------------------- */
+
+// Set the size and type of elements to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 20;
+using ElementTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// PRODUCERS_THROUGHPUT_BENCHMARK: Measures throughput of many producer threads feeding a single consumer thread.
+#define PRODUCERS_THROUGHPUT_BENCHMARK 1
+
+/*
+    These benchmarks measure how fast a single consumer thread drains N elements
+    pushed concurrently by 1 to 16 producer threads, where N is defined by the constant ELEMENT_TEST_SIZE.
+
+    The test uses manual timing to measure the duration from releasing the producers
+    until the consumer has popped all N elements, excluding thread creation.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if PRODUCERS_THROUGHPUT_BENCHMARK
+#define ARGS_B1 ArgsProduct({ { ELEMENT_TEST_SIZE }, { 1, 2, 4, 8, 16 } })->ArgNames({ "N", "Producers" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEMPSCQueue_Throughput,       ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_BoostQueue_MPSCThroughput,    ElementTestType)->ARGS_B1;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include <array>
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- PoolAllocatorBenchmark -------------------------- */
+
+// Set the number of allocations, the number of objects in flight between threads and the allocated type to be used in the benchmarks. 
+static constexpr size_t ALLOCATION_TEST_SIZE = 1 << 20;
+static constexpr size_t IN_FLIGHT_TEST_SIZE = 1 << 10;
+using ElementTestType = std::array<float, 16>;
+using PoolAllocatorTestType = IEPoolAllocator<ElementTestType, sizeof(ElementTestType)>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// ALLOCATE_DEALLOCATE_BENCHMARK: Measures allocation and deallocation on the same thread.
+// CROSS_THREAD_FREE_BENCHMARK: Measures allocation on a producer thread while a consumer thread frees the objects.
+// SPIN_ON_WRITE_BENCHMARK: Measures writes of a heap IESpinOnWriteObject, which allocate one version per write.
+#define ALLOCATE_DEALLOCATE_BENCHMARK 1
+#define CROSS_THREAD_FREE_BENCHMARK 1
+#define SPIN_ON_WRITE_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to allocate and immediately deallocate N objects on a single thread,
+    where N is defined by the constant ALLOCATION_TEST_SIZE.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if ALLOCATE_DEALLOCATE_BENCHMARK
+#define ARGS_B1 Arg(ALLOCATION_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_Allocator_AllocateDeallocate, ElementTestType, PoolAllocatorTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_Allocator_AllocateDeallocate, ElementTestType, std::allocator<ElementTestType>)->ARGS_B1;
+#endif
+
+/*
+    These benchmarks measure the time taken for a producer thread to allocate N objects and hand them through an IESPSCQueue
+    to a consumer thread that frees them, where N is defined by the constant ALLOCATION_TEST_SIZE
+    and at most IN_FLIGHT_TEST_SIZE objects are in flight at any time.
+
+    The test uses manual timing from releasing the consumer until it has freed every object.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if CROSS_THREAD_FREE_BENCHMARK
+#define ARGS_B2 Args({ ALLOCATION_TEST_SIZE, IN_FLIGHT_TEST_SIZE })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_Allocator_CrossThreadFree, ElementTestType, PoolAllocatorTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_Allocator_CrossThreadFree, ElementTestType, std::allocator<ElementTestType>)->ARGS_B2;
+#endif
+
+/*
+    These benchmarks measure the time taken to publish N versions of a heap IESpinOnWriteObject,
+    where N is defined by the constant ALLOCATION_TEST_SIZE and each version is allocated through the given allocator.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if SPIN_ON_WRITE_BENCHMARK
+#define ARGS_B3 Arg(ALLOCATION_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_Allocator_SpinOnWriteObjectWrite, ElementTestType, PoolAllocatorTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_Allocator_SpinOnWriteObjectWrite, ElementTestType, std::allocator<ElementTestType>)->ARGS_B3;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- QueueSelectorBenchmark -------------------------- */
+
+// Set the number of elements, the queue counts and the element type to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 16;
+static constexpr size_t QUEUE_TEST_SIZE = 1 << 6;
+static constexpr size_t SMALL_QUEUES_TEST_NUM = 64;
+static constexpr size_t LARGE_QUEUES_TEST_NUM = 1024;
+static constexpr size_t PUSH_INTERVAL_TEST_NS = 1000;
+using ElementTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// SPARSE_FAN_IN_BENCHMARK: Measures draining many mostly empty queues through IEQueueSelector against polling them all.
+// THREADED_SPARSE_FAN_IN_BENCHMARK: Measures the same fan-in with real producer threads against a parked or a polling consumer.
+#define SPARSE_FAN_IN_BENCHMARK 1
+#define THREADED_SPARSE_FAN_IN_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to push and drain N elements spread over many IESPSCQueue instances of QUEUE_TEST_SIZE elements,
+    where N is defined by the constant ELEMENT_TEST_SIZE.
+    Elements are pushed in rounds of ActiveNum elements to random queues and each round is drained before the next one,
+    so only a few queues hold elements at any time, as with many producers that each send sparsely.
+
+    IEQueueSelector only visits the queues marked in its ready bitmap,
+    while the polling baseline visits every queue on each pass whether it holds elements or not.
+    Both run on a single thread so that the numbers show the consumer's scanning cost alone.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if SPARSE_FAN_IN_BENCHMARK
+#define ARGS_B1 ArgsProduct({ { ELEMENT_TEST_SIZE }, { SMALL_QUEUES_TEST_NUM, LARGE_QUEUES_TEST_NUM }, { 1, 16 }, { QUEUE_TEST_SIZE } })->ArgNames({ "N", "Queues", "ActiveNum", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEQueueSelector_SparseFanIn,      ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_PollingQueues_SparseFanIn,        ElementTestType)->ARGS_B1;
+#endif
+
+/*
+    These benchmarks measure the time taken for producer threads to send N elements to a single consumer thread
+    through LARGE_QUEUES_TEST_NUM queues, each producer owning an equal slice of them,
+    for 1, 2, 4... up to the number of hardware threads producers.
+    Producers push back to back, then once every PUSH_INTERVAL_TEST_NS nanoseconds so that most queues stay empty.
+
+    This includes producers contending on IEQueueSelector's shared ready words and the Notify on a queue's empty to non-empty transition,
+    while its consumer parks in DrainWait. The polling baseline's consumer never parks and rescans every queue.
+    The DrainPasses counter reports the consumer's drain calls per element.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if THREADED_SPARSE_FAN_IN_BENCHMARK
+#define ARGS_B2 Apply([](benchmark::internal::Benchmark* Benchmark) { for (int64_t PushInterval : { size_t(0), PUSH_INTERVAL_TEST_NS }) ApplyThreadsNumRange(Benchmark, { ELEMENT_TEST_SIZE, LARGE_QUEUES_TEST_NUM, 0, QUEUE_TEST_SIZE, PushInterval }, 2); })->ArgNames({ "N", "Queues", "Producers", "QueueSize", "PushIntervalNs" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEQueueSelector_ThreadedSparseFanIn,  ElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_PollingQueues_ThreadedSparseFanIn,    ElementTestType)->ARGS_B2;
+#endif
+
+BENCHMARK_MAIN();
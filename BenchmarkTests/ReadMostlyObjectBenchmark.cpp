@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include <array>
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- ReadMostlyObjectBenchmark -------------------------- */
+
+// Set the number of reads per reader, the object type and the interval between writes to be used in the benchmarks. 
+static constexpr size_t READ_TEST_SIZE = 1 << 18;
+static constexpr size_t WRITE_INTERVAL_US = 10;
+using ElementTestType = std::array<float, 16>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// CONCURRENT_READS_BENCHMARK: Measures read throughput of many reader threads while a writer keeps publishing.
+#define CONCURRENT_READS_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken by 1 to 32 reader threads to each lock and read the shared object N times,
+    where N is defined by the constant READ_TEST_SIZE, while a writer thread publishes a new version every WRITE_INTERVAL_US microseconds.
+
+    The test uses manual timing from releasing the threads until every reader has finished, 
+    and compares IEReadMostlyObject against an object guarded by a std::shared_mutex.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if CONCURRENT_READS_BENCHMARK
+#define ARGS_B1 ArgsProduct({ { READ_TEST_SIZE }, { 1, 2, 4, 8, 16, 32 }, { WRITE_INTERVAL_US } })->ArgNames({ "N", "Readers", "WriteIntervalUs" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IEReadMostlyObject_ConcurrentReads,   ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_SharedMutexObject_ConcurrentReads,    ElementTestType)->ARGS_B1;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- SPMCQueueBenchmark -------------------------- */
+
+// Set the number of elements and the element types to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 20;
+static constexpr size_t LATENCY_TEST_SIZE = 1 << 14;
+using ElementTestType = float;
+using LargeElementTestType = std::array<float, 16>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// THROUGHPUT_BENCHMARK: Measures throughput from a single producer to a growing number of consumers.
+// LATENCY_BENCHMARK: Measures round trips from a single producer through a growing number of competing consumers.
+// LATENCY_HISTOGRAM_BENCHMARK: Measures the distribution of per-element latencies, at saturation and at a fixed rate.
+// FIXED_CAPACITY_BENCHMARK: Measures the compile-time capacity queue against the runtime-sized queue of the same size.
+// LARGE_ELEMENT_BENCHMARK: Measures popping large elements by assignment, into a std::optional and in place with Consume.
+#define THROUGHPUT_BENCHMARK 1
+#define LATENCY_BENCHMARK 1
+#define LATENCY_HISTOGRAM_BENCHMARK 1
+#define FIXED_CAPACITY_BENCHMARK 1
+#define LARGE_ELEMENT_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to move N elements from one producer thread to the consumer threads,
+    where N is defined by the constant ELEMENT_TEST_SIZE, with 1, 2, 4... consumers up to the number of hardware threads.
+    Each queue is run with a 4 byte and a 64 byte element, against boost::lockfree::queue and a std::mutex guarded std::deque.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if THROUGHPUT_BENCHMARK
+#define ARGS_B1 Apply([](benchmark::internal::Benchmark* Benchmark) { ApplyThreadsNumRange(Benchmark, { ELEMENT_TEST_SIZE, 1, 0 }, 2); })->ArgNames({ "N", "Producers", "Consumers" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Throughput,       ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Throughput,       LargeElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_BoostQueue_SPMCThroughput,    ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_BoostQueue_SPMCThroughput,    LargeElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_MutexQueue_SPMCThroughput,    ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_MutexQueue_SPMCThroughput,    LargeElementTestType)->ARGS_B1;
+#endif
+
+/*
+    These benchmarks measure the time taken by N round trips, where N is defined by the constant LATENCY_TEST_SIZE.
+    The producer pushes a single element and waits for it to come back, and whichever consumer pops it replies through a second queue:
+    an IEMPSCQueue for IESPMCQueue, a second queue of the same kind for the baselines.
+    Idle consumers keep polling, so the numbers include their contention on the read position.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if LATENCY_BENCHMARK
+#define ARGS_B2 Apply([](benchmark::internal::Benchmark* Benchmark) { ApplyThreadsNumRange(Benchmark, { LATENCY_TEST_SIZE, 0 }, 1); })->ArgNames({ "N", "Consumers" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Latency,      ElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Latency,      LargeElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_BoostQueue_SPMCLatency,   ElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_BoostQueue_SPMCLatency,   LargeElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_MutexQueue_SPMCLatency,   ElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_MutexQueue_SPMCLatency,   LargeElementTestType)->ARGS_B2;
+#endif
+
+/*
+    These benchmarks timestamp each of N elements at push and record its one-way latency at pop into a log-linear histogram,
+    where N is defined by the constant ELEMENT_TEST_SIZE, in a queue of HISTOGRAM_QUEUE_TEST_SIZE elements,
+    with 1, 2, 4... consumers up to the number of hardware threads.
+    They report the p50, p99, p99.9, p99.99 and max latencies in nanoseconds as the p50Ns, p99Ns, p99.9Ns, p99.99Ns and MaxNs counters.
+
+    The producer either pushes as fast as it can (IntervalNs 0) or paces its pushes HISTOGRAM_INTERVAL_NS nanoseconds apart.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if LATENCY_HISTOGRAM_BENCHMARK
+static constexpr size_t HISTOGRAM_QUEUE_TEST_SIZE = 1 << 10;
+static constexpr size_t HISTOGRAM_INTERVAL_NS = 1000;
+using TimestampTestType = uint64_t;
+#define ARGS_B3 Apply([](benchmark::internal::Benchmark* Benchmark)                                                                 \
+    {                                                                                                                               \
+        ApplyThreadsNumRange(Benchmark, { ELEMENT_TEST_SIZE, 0, 0, HISTOGRAM_QUEUE_TEST_SIZE }, 2);                                  \
+        ApplyThreadsNumRange(Benchmark, { ELEMENT_TEST_SIZE, HISTOGRAM_INTERVAL_NS, 0, HISTOGRAM_QUEUE_TEST_SIZE }, 2);              \
+    })->ArgNames({ "N", "IntervalNs", "Consumers", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_LatencyHistogram,     TimestampTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_BoostQueue_SPMCLatencyHistogram,  TimestampTestType)->ARGS_B3;
+#endif
+
+/*
+    These benchmarks measure the time taken to move N elements from one producer thread to the consumer threads,
+    where N is defined by the constant ELEMENT_TEST_SIZE, through a queue of FIXED_QUEUE_TEST_SIZE elements,
+    with 1, 2, 4... consumers up to the number of hardware threads.
+    IEFixedSPMCQueue has its capacity as a template parameter, wraps its positions with a mask and stores its slots inline.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if FIXED_CAPACITY_BENCHMARK
+static constexpr size_t FIXED_QUEUE_TEST_SIZE = 1 << 10;
+#define ARGS_B4 Apply([](benchmark::internal::Benchmark* Benchmark) { ApplyThreadsNumRange(Benchmark, { ELEMENT_TEST_SIZE, 1, 0, FIXED_QUEUE_TEST_SIZE }, 2); })->ArgNames({ "N", "Producers", "Consumers", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_BoundedThroughput,    ElementTestType)->ARGS_B4;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_BoundedThroughput,    ElementTestType, IEFixedSPMCQueue<ElementTestType, FIXED_QUEUE_TEST_SIZE>)->ARGS_B4;
+#endif
+
+/*
+    These benchmarks evaluate the consumer side of IESPMCQueue with large elements, such as audio blocks.
+    Each iteration pops N elements from a prefilled queue, where N is defined by the constant LARGE_ELEMENT_TEST_SIZE.
+    Each element is either a 256 byte or a 4 KiB block.
+
+    Pop(T&) move-assigns each element into a caller object, Pop() move-constructs it directly into a std::optional,
+    and Consume reads it in place in the queue without copying it out.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if LARGE_ELEMENT_BENCHMARK
+static constexpr size_t LARGE_ELEMENT_TEST_SIZE = 1 << 12;
+using Block256TestType = std::array<float, 64>;
+using Block4KTestType = std::array<float, 1024>;
+#define ARGS_B5 Arg(LARGE_ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Pop,             Block256TestType)->ARGS_B5;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_PopOptional,     Block256TestType)->ARGS_B5;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Consume,         Block256TestType)->ARGS_B5;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Pop,             Block4KTestType)->ARGS_B5;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_PopOptional,     Block4KTestType)->ARGS_B5;
+BENCHMARK_TEMPLATE(BM_IESPMCQueue_Consume,         Block4KTestType)->ARGS_B5;
+#endif
+
+BENCHMARK_MAIN();
@@ -9,25 +9,41 @@
 // Set the size and type of elements to be used in the benchmarks. 
 static constexpr size_t ELEMENT_TEST_SIZE = 1 << 20;
 using ElementTestType = float;
+static constexpr size_t BATCH_TEST_SIZE = 256;
 
 // Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
 // MEMORY_OPERATIONS_BENCHMARK: Measures memory allocation and deallocation performance.
 // INTER_THREAD_LATENCY_BENCHMARK: Measures latency between producer and consumer threads.
+// BULK_OPERATIONS_BENCHMARK: Measures batched push/pop and reserve/commit performance.
+// BLOCKING_WAIT_BENCHMARK: Measures wake-up latency and CPU usage of the waiting operations against busy-spinning.
+// LATENCY_HISTOGRAM_BENCHMARK: Measures the distribution of per-element latencies, at saturation and at a fixed rate.
+// FIXED_CAPACITY_BENCHMARK: Measures compile-time capacity queues against runtime-sized queues of the same size.
+// LARGE_ELEMENT_BENCHMARK: Measures popping large elements by assignment, into a std::optional and in place with Consume.
 #define MEMORY_OPERATIONS_BENCHMARK 1
 #define INTER_THREAD_LATENCY_BENCHMARK 1
+#define BULK_OPERATIONS_BENCHMARK 1
+#define BLOCKING_WAIT_BENCHMARK 1
+#define LATENCY_HISTOGRAM_BENCHMARK 1
+#define FIXED_CAPACITY_BENCHMARK 1
+#define LARGE_ELEMENT_BENCHMARK 1
 
 /*
     These benchmarks evaluate the performance of push and pop operations separately.
     Each iteration measures the time taken to either push or pop N elements, 
     where N is defined by the constant ELEMENT_TEST_SIZE.
 
+    The IESPSCQueue benchmarks also run against IESPSCCachedQueue, which synchronizes through
+    cached write/read indices instead of the shared size counter.
+
     All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
 */
 #if MEMORY_OPERATIONS_BENCHMARK
 #define ARGS_B1 Arg(ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
 BENCHMARK_TEMPLATE(BM_IESPSCQueue_Push,     ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Push,     ElementTestType, IESPSCCachedQueue<ElementTestType>)->ARGS_B1;
 BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_Push,  ElementTestType)->ARGS_B1;
 BENCHMARK_TEMPLATE(BM_IESPSCQueue_Pop,      ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Pop,      ElementTestType, IESPSCCachedQueue<ElementTestType>)->ARGS_B1;
 BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_Pop,   ElementTestType)->ARGS_B1;
 #endif
 
@@ -40,12 +56,117 @@ BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_Pop,   ElementTestType)->ARGS_B1;
     The test uses manual timing to precisely measure the duration of N complete cycles,
     excluding thread overhead.
 
+    The IEStats variant measures the overhead of enabling the stats policy on the same queue.
+
     All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
 */
 #if INTER_THREAD_LATENCY_BENCHMARK
 #define ARGS_B2 Arg(ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
 BENCHMARK_TEMPLATE(BM_IESPSCQueue_Latency,      ElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Latency,      ElementTestType, IESPSCCachedQueue<ElementTestType>)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Latency,      ElementTestType, IESPSCQueue<ElementTestType, std::allocator<ElementTestType>, IEStats>)->ARGS_B2;
 BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_Latency,   ElementTestType)->ARGS_B2;
 #endif
 
+/*
+    These benchmarks evaluate batched operations, where a whole batch is published with a single atomic update.
+    Each iteration moves N elements in batches of BATCH_TEST_SIZE elements, 
+    first on a single thread and then streamed between a producer and a consumer thread.
+
+    The streaming variants compare copying batches in and out (PushBulk/PopBulk)
+    against writing and reading directly in the ring (ReserveWrite/CommitWrite, ReserveRead/CommitRead).
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if BULK_OPERATIONS_BENCHMARK
+#define ARGS_B3 Args({ ELEMENT_TEST_SIZE, BATCH_TEST_SIZE })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_PushBulk,                 ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_PushBulk,              ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_PopBulk,                  ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_PopBulk,               ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_BulkStreaming,            ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_ReserveCommitStreaming,   ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_BulkStreaming,         ElementTestType)->ARGS_B3;
+#endif
+
+/*
+    These benchmarks compare the waiting operations (PushWait/PopWait), which spin briefly and then park the thread,
+    against busy-spinning on Push/Pop.
+
+    The first benchmark repeats the round-trip latency test above using the waiting operations on both sides.
+    The rate-limited benchmarks push WAKEUP_TEST_SIZE timestamps spaced WAKEUP_INTERVAL_US microseconds apart,
+    and report the average time for the consumer to observe each one as the WakeUpLatencyNs counter.
+    They measure process CPU time, so the CPU column against the Time column shows how many cores stayed busy while idle.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if BLOCKING_WAIT_BENCHMARK
+static constexpr size_t WAKEUP_TEST_SIZE = 1 << 12;
+static constexpr size_t WAKEUP_INTERVAL_US = 50;
+#define ARGS_B4 Arg(ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+#define ARGS_B5 Args({ WAKEUP_TEST_SIZE, WAKEUP_INTERVAL_US })->Unit(benchmark::kMillisecond)->MeasureProcessCPUTime()->UseRealTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_WaitLatency,          ElementTestType)->ARGS_B4;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_RateLimitedWakeUp,    false)->ARGS_B5;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_RateLimitedWakeUp,    true)->ARGS_B5;
+#endif
+
+/*
+    These benchmarks timestamp each of N elements at push and record its one-way latency at pop into a log-linear histogram,
+    where N is defined by the constant ELEMENT_TEST_SIZE, in a queue of HISTOGRAM_QUEUE_TEST_SIZE elements.
+    They report the p50, p99, p99.9, p99.99 and max latencies in nanoseconds as the p50Ns, p99Ns, p99.9Ns, p99.99Ns and MaxNs counters.
+
+    The producer either pushes as fast as it can (IntervalNs 0), which mostly measures the time spent waiting in a full queue,
+    or paces its pushes HISTOGRAM_INTERVAL_NS nanoseconds apart, which measures the hand-off itself under a realistic load.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if LATENCY_HISTOGRAM_BENCHMARK
+static constexpr size_t HISTOGRAM_QUEUE_TEST_SIZE = 1 << 10;
+static constexpr size_t HISTOGRAM_INTERVAL_NS = 1000;
+using TimestampTestType = uint64_t;
+#define ARGS_B6 ArgsProduct({ { ELEMENT_TEST_SIZE }, { 0, HISTOGRAM_INTERVAL_NS }, { 1 }, { HISTOGRAM_QUEUE_TEST_SIZE } })->ArgNames({ "N", "IntervalNs", "Consumers", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_LatencyHistogram,     TimestampTestType)->ARGS_B6;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_LatencyHistogram,     TimestampTestType, IESPSCCachedQueue<TimestampTestType>)->ARGS_B6;
+BENCHMARK_TEMPLATE(BM_BoostSPSCQueue_LatencyHistogram,  TimestampTestType)->ARGS_B6;
+#endif
+
+/*
+    These benchmarks measure the time taken to stream N elements from a producer thread to a consumer thread,
+    where N is defined by the constant ELEMENT_TEST_SIZE, through a queue of FIXED_QUEUE_TEST_SIZE elements.
+    IEFixedSPSCQueue has its capacity as a template parameter, wraps its indices with a mask and stores its ring inline,
+    while the runtime-sized queues wrap with a compare and reach their ring through a pointer.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if FIXED_CAPACITY_BENCHMARK
+static constexpr size_t FIXED_QUEUE_TEST_SIZE = 1 << 10;
+#define ARGS_B7 Args({ ELEMENT_TEST_SIZE, FIXED_QUEUE_TEST_SIZE })->ArgNames({ "N", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Streaming,    ElementTestType)->ARGS_B7;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Streaming,    ElementTestType, IESPSCCachedQueue<ElementTestType>)->ARGS_B7;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Streaming,    ElementTestType, IEFixedSPSCQueue<ElementTestType, FIXED_QUEUE_TEST_SIZE>)->ARGS_B7;
+#endif
+
+/*
+    These benchmarks evaluate the consumer side of IESPSCQueue with large elements, such as audio blocks.
+    Each iteration pops N elements from a prefilled queue, where N is defined by the constant LARGE_ELEMENT_TEST_SIZE.
+    Each element is either a 256 byte or a 4 KiB block.
+
+    Pop(T&) move-assigns each element into a caller object, Pop() move-constructs it directly into a std::optional,
+    and Consume reads it in place in the queue without copying it out.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if LARGE_ELEMENT_BENCHMARK
+static constexpr size_t LARGE_ELEMENT_TEST_SIZE = 1 << 12;
+using Block256TestType = std::array<float, 64>;
+using Block4KTestType = std::array<float, 1024>;
+#define ARGS_B8 Arg(LARGE_ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Pop,             Block256TestType)->ARGS_B8;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_PopOptional,     Block256TestType)->ARGS_B8;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Consume,         Block256TestType)->ARGS_B8;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Pop,             Block4KTestType)->ARGS_B8;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_PopOptional,     Block4KTestType)->ARGS_B8;
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Consume,         Block4KTestType)->ARGS_B8;
+#endif
+
 BENCHMARK_MAIN();
\ No newline at end of file
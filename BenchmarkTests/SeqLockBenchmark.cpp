@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include <array>
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- SeqLockBenchmark -------------------------- */
+
+// Set the number of reads per reader and the trivially copyable object type to be used in the benchmarks. 
+static constexpr size_t READ_TEST_SIZE = 1 << 18;
+using ElementTestType = std::array<double, 4>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// READS_UNDER_WRITE_BENCHMARK: Measures read throughput while a writer publishes continuously or every 10 microseconds.
+#define READS_UNDER_WRITE_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken by the reader threads to each copy the shared object N times,
+    where N is defined by the constant READ_TEST_SIZE, while a writer thread publishes a new value every WriteIntervalUs microseconds.
+    A WriteIntervalUs of 0 keeps the writer publishing back to back.
+
+    IESpinOnWriteObject only supports a single reader, so it is measured with one reader thread
+    while IESeqLock and the std::shared_mutex guarded object are measured with 1 to 16 reader threads.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if READS_UNDER_WRITE_BENCHMARK
+#define ARGS_B1(...) ArgsProduct({ { READ_TEST_SIZE }, __VA_ARGS__, { 0, 10 } })->ArgNames({ "N", "Readers", "WriteIntervalUs" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESeqLock_ConcurrentReads,            ElementTestType)->ARGS_B1({ 1, 2, 4, 8, 16 });
+BENCHMARK_TEMPLATE(BM_SharedMutexObject_ConcurrentReads,    ElementTestType)->ARGS_B1({ 1, 2, 4, 8, 16 });
+BENCHMARK_TEMPLATE(BM_IESpinOnWriteObject_ConcurrentReads,  ElementTestType)->ARGS_B1({ 1 });
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include <array>
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- SharedMemoryQueueBenchmark -------------------------- */
+
+// Set the number of round trips and the type of elements to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 16;
+using ElementTestType = std::array<float, 16>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// CROSS_PROCESS_LATENCY_BENCHMARK: Measures round trips between a parent process and a forked child process.
+#define CROSS_PROCESS_LATENCY_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken for N elements to travel from a parent process to a forked child process and back,
+    where N is defined by the constant ELEMENT_TEST_SIZE, one element in flight at a time.
+
+    The shared memory queues are created anonymously before forking, so both processes map the same region,
+    and are compared against a Unix domain socket pair copying the same elements.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if CROSS_PROCESS_LATENCY_BENCHMARK && defined(__linux__)
+#define ARGS_B1 Arg(ELEMENT_TEST_SIZE)->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESharedMemorySPSCQueue_CrossProcessLatency,  ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_SocketPair_CrossProcessLatency,               ElementTestType)->ARGS_B1;
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- SpinOnWriteObjectBenchmark -------------------------- */
+
+// Set the number of operations, the object type and its numbers of elements to be used in the benchmarks. 
+static constexpr size_t OPERATION_TEST_SIZE = 1 << 16;
+static constexpr size_t SMALL_OBJECT_TEST_SIZE = 1 << 4;
+static constexpr size_t MEDIUM_OBJECT_TEST_SIZE = 1 << 10;
+static constexpr size_t LARGE_OBJECT_TEST_SIZE = 1 << 14;
+using ElementTestType = std::vector<float>;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// WRITE_THROUGHPUT_BENCHMARK: Measures how many writes per second a single writer thread can publish.
+// READ_LATENCY_BENCHMARK: Measures the cost of a read lock while a writer keeps publishing.
+#define WRITE_THROUGHPUT_BENCHMARK 1
+#define READ_LATENCY_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to publish N new versions of the object without any reader,
+    where N is defined by the constant OPERATION_TEST_SIZE,
+    comparing heap allocated versions against preallocated versions reused in place, the wait-free IETripleBuffer
+    and a std::mutex guarded copy, for objects of 16, 1024 and 16384 elements.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if WRITE_THROUGHPUT_BENCHMARK
+#define ARGS_B1 ArgsProduct({ { OPERATION_TEST_SIZE }, { SMALL_OBJECT_TEST_SIZE, MEDIUM_OBJECT_TEST_SIZE, LARGE_OBJECT_TEST_SIZE } })->ArgNames({ "N", "ObjectSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESpinOnWriteObject_Write,    ElementTestType, IESpinOnWriteStorage::Heap)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IESpinOnWriteObject_Write,    ElementTestType, IESpinOnWriteStorage::Preallocated)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IETripleBuffer_Write,         ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_MutexObject_Write,            ElementTestType)->ARGS_B1;
+#endif
+
+/*
+    These benchmarks measure the time taken by a reader thread to lock and read the object N times,
+    where N is defined by the constant OPERATION_TEST_SIZE, while a writer thread publishes new versions in a loop.
+    IETripleBuffer readers pick up the latest published value instead of locking, and its writer never waits on the reader.
+    The std::mutex and std::shared_mutex baselines hold their lock for the whole read, as IESpinOnWriteObject does.
+
+    IESpinOnWriteObject supports a single reader, so every benchmark here runs one reader thread.
+    Reader scaling over many threads is covered by ReadMostlyObjectBenchmark and SeqLockBenchmark.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if READ_LATENCY_BENCHMARK
+#define ARGS_B2 ArgsProduct({ { OPERATION_TEST_SIZE }, { SMALL_OBJECT_TEST_SIZE, MEDIUM_OBJECT_TEST_SIZE, LARGE_OBJECT_TEST_SIZE } })->ArgNames({ "N", "ObjectSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESpinOnWriteObject_ReadLatency,  ElementTestType, IESpinOnWriteStorage::Heap)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_IESpinOnWriteObject_ReadLatency,  ElementTestType, IESpinOnWriteStorage::Preallocated)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_IETripleBuffer_ReadLatency,       ElementTestType)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_MutexObject_ReadLatency,          ElementTestType, std::mutex)->ARGS_B2;
+BENCHMARK_TEMPLATE(BM_MutexObject_ReadLatency,          ElementTestType, std::shared_mutex)->ARGS_B2;
+#endif
+
+BENCHMARK_MAIN();
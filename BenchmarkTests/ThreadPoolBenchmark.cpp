@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- ThreadPoolBenchmark -------------------------- */
+
+// Set the workload sizes and element types to be used in the benchmarks. 
+static constexpr size_t PARALLEL_FOR_TEST_SIZE = 1 << 22;
+static constexpr size_t PARALLEL_FOR_GRAIN = 1 << 10;
+static constexpr size_t FIB_TEST_INDEX = 32;
+static constexpr size_t FIB_SERIAL_INDEX = 12;
+using ElementTestType = float;
+using FibTestType = uint64_t;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// PARALLEL_FOR_BENCHMARK: Measures a flat data-parallel loop recursively split across the workers.
+// FIB_BENCHMARK: Measures a deeply recursive fork-join workload dominated by task spawning and stealing.
+#define PARALLEL_FOR_BENCHMARK 1
+#define FIB_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken by IEThreadPool::ParallelFor to compute N elements,
+    where N is defined by the constant PARALLEL_FOR_TEST_SIZE, splitting the range down to chunks of PARALLEL_FOR_GRAIN elements, with 1, 2, 4... workers up to the number of hardware threads.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if PARALLEL_FOR_BENCHMARK
+BENCHMARK_TEMPLATE(BM_IEThreadPool_ParallelFor, ElementTestType)->Apply([](benchmark::internal::Benchmark* Benchmark) { ApplyThreadsNumRange(Benchmark, { PARALLEL_FOR_TEST_SIZE, 0, PARALLEL_FOR_GRAIN }, 1); })
+    ->ArgNames({ "N", "Workers", "Grain" })->Unit(benchmark::kMicrosecond)->UseManualTime();
+#endif
+
+/*
+    These benchmarks measure the time taken to compute the Fibonacci number at FIB_TEST_INDEX with a fork-join per call,
+    falling back to the serial recursion at FIB_SERIAL_INDEX so that tasks are small but not trivial.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if FIB_BENCHMARK
+BENCHMARK_TEMPLATE(BM_IEThreadPool_Fib, FibTestType)->Apply([](benchmark::internal::Benchmark* Benchmark) { ApplyThreadsNumRange(Benchmark, { FIB_TEST_INDEX, 0, FIB_SERIAL_INDEX }, 1); })
+    ->ArgNames({ "Index", "Workers", "SerialIndex" })->Unit(benchmark::kMicrosecond)->UseManualTime();
+#endif
+
+BENCHMARK_MAIN();
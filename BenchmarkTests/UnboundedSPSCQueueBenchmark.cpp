@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEConcurrencyBenchmarkFunctions.h"
+
+/* -------------------------- UnboundedSPSCQueueBenchmark -------------------------- */
+
+// Set the number of elements, the burst and queue sizes and the element type to be used in the benchmarks. 
+static constexpr size_t ELEMENT_TEST_SIZE = 1 << 20;
+static constexpr size_t LARGE_QUEUE_TEST_SIZE = 1 << 16;
+static constexpr size_t SMALL_QUEUE_TEST_SIZE = 1 << 10;
+static constexpr size_t BURST_TEST_SIZE = 1 << 16;
+using ElementTestType = float;
+
+// Set the following macros to 0/1 to enable/disable the corresponding benchmark tests:
+// STEADY_STATE_BENCHMARK: Measures streaming throughput once segments are recycled, against a large IESPSCQueue.
+// BURSTS_BENCHMARK: Measures absorbing bursts, against an IESPSCQueue sized for the whole burst and one sized below it.
+#define STEADY_STATE_BENCHMARK 1
+#define BURSTS_BENCHMARK 1
+
+/*
+    These benchmarks measure the time taken to stream N elements from a producer thread to a consumer thread,
+    where N is defined by the constant ELEMENT_TEST_SIZE.
+
+    IEUnboundedSPSCQueue reuses the segments its consumer recycles, so after the first segments it no longer allocates,
+    and it runs against an IESPSCQueue of LARGE_QUEUE_TEST_SIZE elements.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if STEADY_STATE_BENCHMARK
+#define ARGS_B1 Args({ ELEMENT_TEST_SIZE, LARGE_QUEUE_TEST_SIZE })->ArgNames({ "N", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+#define ARGS_B2 Arg(ELEMENT_TEST_SIZE)->ArgName("N")->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Streaming,            ElementTestType)->ARGS_B1;
+BENCHMARK_TEMPLATE(BM_IEUnboundedSPSCQueue_Streaming,   ElementTestType)->ARGS_B2;
+#endif
+
+/*
+    These benchmarks push N elements in bursts of BURST_TEST_SIZE elements, each burst drained by the consumer before the next one.
+    The BurstPushNs counter reports how long the producer took to push a whole burst.
+
+    An IESPSCQueue of BURST_TEST_SIZE elements absorbs the burst but holds that memory for good,
+    an IESPSCQueue of SMALL_QUEUE_TEST_SIZE elements stalls the producer until the consumer catches up,
+    while IEUnboundedSPSCQueue grows by segments and then keeps them for the next burst.
+
+    All benchmark functions are defined in the IEConcurrencyBenchmarkFunctions.h file.
+*/
+#if BURSTS_BENCHMARK
+#define ARGS_B3 ArgsProduct({ { ELEMENT_TEST_SIZE }, { BURST_TEST_SIZE }, { BURST_TEST_SIZE, SMALL_QUEUE_TEST_SIZE } })->ArgNames({ "N", "BurstSize", "QueueSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+#define ARGS_B4 Args({ ELEMENT_TEST_SIZE, BURST_TEST_SIZE })->ArgNames({ "N", "BurstSize" })->Unit(benchmark::kMicrosecond)->UseManualTime()
+BENCHMARK_TEMPLATE(BM_IESPSCQueue_Bursts,           ElementTestType)->ARGS_B3;
+BENCHMARK_TEMPLATE(BM_IEUnboundedSPSCQueue_Bursts,  ElementTestType)->ARGS_B4;
+#endif
+
+BENCHMARK_MAIN();
@@ -50,6 +50,47 @@ static void Demo_IESpinOnWriteObject()
     std::printf("\nIESpinOnWriteObject Demo Finished.\n");
 }
 
+static void Demo_IETripleBuffer()
+{
+    /*
+        This demo runs the same Reader/Writer scenario as the IESpinOnWriteObject demo using an IETripleBuffer<std::string>.
+        The Reader thread keeps reading its front buffer for a while, but the Writer thread is never blocked and publishes immediately.
+        On its second read, the Reader picks up the freshly published data.
+        Notably, both the read and the write operations are wait-free.
+    */
+    std::printf("\nIETripleBuffer Demo Started.\n\n");
+
+    IETripleBuffer<std::string> Data(std::string("[OLD DATA]"));
+    const int ReaderSimulatedWorkTime = 2000;
+
+    std::thread Reader([&Data](int SimulatedWorkTime)
+        {
+            for (int i = 0; i < 2; i++)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(300)); // Add small delay between reads
+                const bool bIsFresh = Data.Update();
+                std::printf("Reader thread: Reading %s Data %s\n", bIsFresh ? "Fresh" : "Current", Data.GetReadBuffer().c_str());
+                std::this_thread::sleep_for(std::chrono::milliseconds(SimulatedWorkTime));
+                std::printf("Reader thread: Done Reading\n");
+            }
+
+        }, ReaderSimulatedWorkTime);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(400)); // Add small delay before writing new data.
+    std::thread Writer([&Data]()
+        {
+            std::printf("Writer thread: Writing New Data...\n");
+            std::string NewData = std::string("[NEW DATA]");
+            Data.Write(NewData);
+            std::printf("Writer thread: New Data Written %s\n", NewData.c_str());
+        });
+
+    Writer.join();
+    Reader.join();
+
+    std::printf("\nIETripleBuffer Demo Finished.\n");
+}
+
 static void Demo_IESPSCQueue()
 {
     /*
@@ -195,6 +236,7 @@ int main()
 {
     /* Comment/Uncomment Demo to run */
     Demo_IESpinOnWriteObject();
+    Demo_IETripleBuffer();
     Demo_IESPSCQueue();
     Demo_IESPMCQueue();
     
@@ -4,6 +4,30 @@
 
 #pragma once
 
+#include "Source/IEBlockPool.h"
+#include "Source/IEBroadcastRing.h"
+#include "Source/IEByteRingBuffer.h"
+#include "Source/IEConcurrentHashMap.h"
+#include "Source/IECoroutineExecutor.h"
+#include "Source/IEEventCount.h"
+#include "Source/IEFixedSPMCQueue.h"
+#include "Source/IEFixedSPSCQueue.h"
+#include "Source/IEHugePageAllocator.h"
+#include "Source/IEMPMCQueue.h"
+#include "Source/IEMPSCQueue.h"
+#include "Source/IEPoolAllocator.h"
+#include "Source/IEQueueAwaiter.h"
+#include "Source/IEQueueSelector.h"
+#include "Source/IEReadIndicator.h"
+#include "Source/IEReadMostlyObject.h"
+#include "Source/IESeqLock.h"
+#include "Source/IESharedMemorySPSCQueue.h"
 #include "Source/IESpinOnWriteObject.h"
 #include "Source/IESPMCQueue.h"
-#include "Source/IESPSCQueue.h"
\ No newline at end of file
+#include "Source/IESPSCCachedQueue.h"
+#include "Source/IESPSCQueue.h"
+#include "Source/IEStats.h"
+#include "Source/IEThreadPool.h"
+#include "Source/IETripleBuffer.h"
+#include "Source/IEUnboundedSPSCQueue.h"
+#include "Source/IEWorkStealingDeque.h"
\ No newline at end of file
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Lock-free pool of fixed-size blocks carved out of a single arena allocated and touched at construction.
+    Free blocks are linked by index into Treiber stacks whose heads pack a 32-bit block index with a 32-bit tag against ABA.
+    Every thread frees into and allocates from its own padded stripe. When a stripe runs dry,
+    the thread takes a whole list at once from the shared list or another stripe, so blocks freed on a consumer thread
+    flow back to the producer thread in batches instead of one contended CAS per block.
+*/
+class IEBlockPool
+{
+public:
+    static constexpr size_t StripesNum = 16;
+    static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+public:
+    IEBlockPool(size_t BlockSize, size_t BlocksNum) :
+        m_BlockSize((std::max<size_t>(BlockSize, 1) + BlockAlignment - 1) / BlockAlignment * BlockAlignment),
+        m_BlocksNum(std::min<size_t>(BlocksNum, m_EmptyIndex)),
+        m_Arena(static_cast<std::byte*>(::operator new(m_BlockSize * m_BlocksNum, std::align_val_t(IE_CACHE_LINE_SIZE)))),
+        m_NextIndices(std::make_unique<std::atomic<uint32_t>[]>(m_BlocksNum))
+    {
+        // Touch every page now so the hot path never page-faults.
+        std::memset(m_Arena, 0, m_BlockSize * m_BlocksNum);
+        for (size_t i = 0; i < m_BlocksNum; i++)
+        {
+            m_NextIndices[i].store(i + 1 < m_BlocksNum ? static_cast<uint32_t>(i + 1) : m_EmptyIndex, std::memory_order_relaxed);
+        }
+        m_SharedList.Head.store(MakeHead(m_BlocksNum > 0 ? 0 : m_EmptyIndex, 0), std::memory_order_relaxed);
+    }
+    IEBlockPool(const IEBlockPool&) = delete;
+    IEBlockPool& operator=(const IEBlockPool&) = delete;
+    ~IEBlockPool()
+    {
+        ::operator delete(m_Arena, std::align_val_t(IE_CACHE_LINE_SIZE));
+    }
+
+public:
+    // Returns nullptr when every block is in use.
+    void* Allocate()
+    {
+        FreeList& LocalList = m_Stripes[IEGetThreadIndex() % StripesNum];
+        uint32_t Index = PopBlock(LocalList);
+        if (IE_UNLIKELY(Index == m_EmptyIndex))
+        {
+            Index = RefillFrom(LocalList);
+        }
+        return Index == m_EmptyIndex ? nullptr : m_Arena + static_cast<size_t>(Index) * m_BlockSize;
+    }
+
+    void Deallocate(void* Block)
+    {
+        const uint32_t Index = static_cast<uint32_t>((static_cast<std::byte*>(Block) - m_Arena) / m_BlockSize);
+        PushBlocks(m_Stripes[IEGetThreadIndex() % StripesNum], Index, Index);
+    }
+
+    bool Owns(const void* Block) const
+    {
+        const std::byte* BlockAddress = static_cast<const std::byte*>(Block);
+        return std::less_equal<const std::byte*>()(m_Arena, BlockAddress) && std::less<const std::byte*>()(BlockAddress, m_Arena + m_BlockSize * m_BlocksNum);
+    }
+
+    size_t GetBlockSize() const
+    {
+        return m_BlockSize;
+    }
+
+    size_t GetBlocksNum() const
+    {
+        return m_BlocksNum;
+    }
+
+private:
+    struct alignas(IE_CACHE_LINE_SIZE) FreeList
+    {
+        std::atomic<uint64_t> Head{ MakeHead(m_EmptyIndex, 0) };
+    };
+
+    static constexpr uint64_t MakeHead(uint32_t Index, uint32_t Tag)
+    {
+        return (static_cast<uint64_t>(Tag) << 32) | Index;
+    }
+
+    static constexpr uint32_t GetIndex(uint64_t Head)
+    {
+        return static_cast<uint32_t>(Head);
+    }
+
+    static constexpr uint32_t GetTag(uint64_t Head)
+    {
+        return static_cast<uint32_t>(Head >> 32);
+    }
+
+    uint32_t PopBlock(FreeList& List)
+    {
+        uint64_t Head = List.Head.load(std::memory_order_acquire);
+        while (GetIndex(Head) != m_EmptyIndex)
+        {
+            const uint32_t NextIndex = m_NextIndices[GetIndex(Head)].load(std::memory_order_relaxed);
+            if (List.Head.compare_exchange_weak(Head, MakeHead(NextIndex, GetTag(Head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return GetIndex(Head);
+            }
+        }
+        return m_EmptyIndex;
+    }
+
+    // Detaches the whole list, returns the index of its first block.
+    uint32_t TakeAll(FreeList& List)
+    {
+        uint64_t Head = List.Head.load(std::memory_order_acquire);
+        while (GetIndex(Head) != m_EmptyIndex)
+        {
+            if (List.Head.compare_exchange_weak(Head, MakeHead(m_EmptyIndex, GetTag(Head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return GetIndex(Head);
+            }
+        }
+        return m_EmptyIndex;
+    }
+
+    // Pushes the chain of blocks linked from FirstIndex to LastIndex.
+    void PushBlocks(FreeList& List, uint32_t FirstIndex, uint32_t LastIndex)
+    {
+        uint64_t Head = List.Head.load(std::memory_order_relaxed);
+        do
+        {
+            m_NextIndices[LastIndex].store(GetIndex(Head), std::memory_order_relaxed);
+        } while (!List.Head.compare_exchange_weak(Head, MakeHead(FirstIndex, GetTag(Head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Slow path, moves a whole list from the shared list or another stripe into LocalList and returns one block of it.
+    uint32_t RefillFrom(FreeList& LocalList)
+    {
+        uint32_t FirstIndex = TakeAll(m_SharedList);
+        const size_t LocalStripe = static_cast<size_t>(&LocalList - m_Stripes);
+        for (size_t i = 1; FirstIndex == m_EmptyIndex && i < StripesNum; i++)
+        {
+            FirstIndex = TakeAll(m_Stripes[(LocalStripe + i) % StripesNum]);
+        }
+        if (FirstIndex == m_EmptyIndex)
+        {
+            return m_EmptyIndex;
+        }
+
+        const uint32_t SecondIndex = m_NextIndices[FirstIndex].load(std::memory_order_relaxed);
+        if (SecondIndex != m_EmptyIndex)
+        {
+            uint32_t LastIndex = SecondIndex;
+            for (uint32_t NextIndex = m_NextIndices[LastIndex].load(std::memory_order_relaxed); NextIndex != m_EmptyIndex; NextIndex = m_NextIndices[LastIndex].load(std::memory_order_relaxed))
+            {
+                LastIndex = NextIndex;
+            }
+            PushBlocks(LocalList, SecondIndex, LastIndex);
+        }
+        return FirstIndex;
+    }
+
+private:
+    static constexpr uint32_t m_EmptyIndex = UINT32_MAX;
+    const size_t m_BlockSize;
+    const size_t m_BlocksNum;
+    std::byte* const m_Arena;
+    const std::unique_ptr<std::atomic<uint32_t>[]> m_NextIndices;
+
+    FreeList m_SharedList;
+    FreeList m_Stripes[StripesNum];
+};
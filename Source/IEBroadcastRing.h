@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#include "IEConcurrencyCommon.h"
+
+enum class IEBroadcastMode
+{
+    // The producer waits for the slowest subscriber, so every subscriber receives every element.
+    Gated,
+    // The producer never waits and overwrites the oldest elements, subscribers that fall a full ring behind skip ahead.
+    Overwrite
+};
+
+/*
+    Single-producer multi-subscriber ring where every subscriber receives every element, which is written only once.
+    Each subscriber owns a padded read cursor and finds ready slots through per-slot stamps, without touching the producer's cache lines.
+    In Gated mode the producer keeps a cached copy of the slowest cursor and only rescans the cursors when the ring appears full.
+    In Overwrite mode a slot's stamp is odd while it is being rewritten, and subscribers validate their copy against it as in IESeqLock.
+    Elements are stored as relaxed atomic words so that copy is well defined, which is why T must be trivially copyable.
+*/
+template<typename T, IEBroadcastMode Mode = IEBroadcastMode::Gated, typename Allocator = std::allocator<T>>
+requires std::is_trivially_copyable_v<T>
+class IEBroadcastRing : private Allocator
+{
+private:
+    using Word = uint64_t;
+    static constexpr size_t m_WordsNum = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    // Stamp is 2 * Position + 2 once the element at Position is written, 2 * Position + 1 while it is being overwritten.
+    struct Slot
+    {
+        std::atomic<uint64_t> Stamp{ 0 };
+        std::atomic<Word> Words[m_WordsNum];
+    };
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+    struct alignas(IE_CACHE_LINE_SIZE) Cursor
+    {
+        std::atomic<size_t> ReadPosition{ 0 };
+        size_t DroppedNum = 0;
+    };
+
+public:
+    using ValueType = T;
+    // Size is rounded up to a power of two.
+    IEBroadcastRing(size_t Size, size_t SubscribersNum, const Allocator& RingAllocator = Allocator()) :
+        Allocator(RingAllocator),
+        m_Capacity(std::bit_ceil(std::max<size_t>(Size, 2))),
+        m_IndexMask(m_Capacity - 1),
+        m_Slots(AllocateSlots()),
+        m_SubscribersNum(SubscribersNum),
+        m_Cursors(std::make_unique<Cursor[]>(SubscribersNum))
+    {}
+    IEBroadcastRing(const IEBroadcastRing&) = delete;
+    IEBroadcastRing& operator=(const IEBroadcastRing&) = delete;
+    ~IEBroadcastRing()
+    {
+        SlotAllocator SlotAlloc(*this);
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            std::allocator_traits<SlotAllocator>::destroy(SlotAlloc, m_Slots + i);
+        }
+        std::allocator_traits<SlotAllocator>::deallocate(SlotAlloc, m_Slots, m_Capacity);
+    }
+
+    // Producer only. Returns false in Gated mode when the slowest subscriber is a full ring behind.
+    bool Push(const T& Element)
+    {
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+        Slot& WriteSlot = m_Slots[WritePosition & m_IndexMask];
+        if constexpr (Mode == IEBroadcastMode::Gated)
+        {
+            if (IE_UNLIKELY(WritePosition - m_CachedMinReadPosition == m_Capacity))
+            {
+                m_CachedMinReadPosition = LoadMinReadPosition();
+                if (WritePosition - m_CachedMinReadPosition == m_Capacity)
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            WriteSlot.Stamp.store(2 * WritePosition + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        Word Words[m_WordsNum] = {};
+        std::memcpy(Words, &Element, sizeof(T));
+        for (size_t i = 0; i < m_WordsNum; i++)
+        {
+            WriteSlot.Words[i].store(Words[i], std::memory_order_relaxed);
+        }
+        WriteSlot.Stamp.store(2 * WritePosition + 2, std::memory_order_release);
+        m_WritePosition.store(WritePosition + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(size_t SubscriberIndex, T& Element)
+    {
+        return Consume(SubscriberIndex, [&](const T& NextElement) { std::memcpy(&Element, &NextElement, sizeof(T)); });
+    }
+
+    std::optional<T> Pop(size_t SubscriberIndex)
+    {
+        std::optional<T> Element;
+        Consume(SubscriberIndex, [&](const T& NextElement) { Element.emplace(NextElement); });
+        return Element;
+    }
+
+    /*
+        Subscriber only, each subscriber index must be used by a single thread at a time.
+        Calls Function(const T&) on a local copy of the subscriber's next element, returns false when there is none.
+        The slot is released before Function runs, so a slow Function never holds up the producer.
+    */
+    template <typename FunctionType>
+    bool Consume(size_t SubscriberIndex, FunctionType&& Function)
+    {
+        Cursor& SubscriberCursor = m_Cursors[SubscriberIndex];
+        size_t ReadPosition = SubscriberCursor.ReadPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const Slot& ReadSlot = m_Slots[ReadPosition & m_IndexMask];
+            const uint64_t ExpectedStamp = 2 * ReadPosition + 2;
+            const uint64_t Stamp = ReadSlot.Stamp.load(std::memory_order_acquire);
+            if (Stamp < ExpectedStamp)
+            {
+                return false;
+            }
+
+            Word Words[m_WordsNum];
+            if constexpr (Mode == IEBroadcastMode::Overwrite)
+            {
+                if (Stamp == ExpectedStamp)
+                {
+                    LoadWords(ReadSlot, Words);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                }
+                if (Stamp != ExpectedStamp || ReadSlot.Stamp.load(std::memory_order_relaxed) != ExpectedStamp)
+                {
+                    ReadPosition = SkipToOldest(SubscriberCursor, ReadPosition);
+                    continue;
+                }
+            }
+            else
+            {
+                LoadWords(ReadSlot, Words);
+            }
+
+            // Copying the bytes creates the element, as T is trivially copyable, so it needs no default constructor.
+            alignas(T) std::byte ElementStorage[sizeof(T)];
+            std::memcpy(ElementStorage, Words, sizeof(T));
+            SubscriberCursor.ReadPosition.store(ReadPosition + 1, std::memory_order_release);
+            Function(std::as_const(*std::launder(reinterpret_cast<T*>(ElementStorage))));
+            return true;
+        }
+    }
+
+    // Subscriber only. Number of elements overwritten before the subscriber could read them, always 0 in Gated mode.
+    size_t GetDroppedNum(size_t SubscriberIndex) const
+    {
+        return m_Cursors[SubscriberIndex].DroppedNum;
+    }
+
+    bool IsEmpty(size_t SubscriberIndex) const
+    {
+        return m_Cursors[SubscriberIndex].ReadPosition.load(std::memory_order_acquire) == m_WritePosition.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+    size_t GetSubscribersNum() const
+    {
+        return m_SubscribersNum;
+    }
+
+private:
+    Slot* AllocateSlots()
+    {
+        SlotAllocator SlotAlloc(*this);
+        Slot* Slots = std::allocator_traits<SlotAllocator>::allocate(SlotAlloc, m_Capacity);
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            std::allocator_traits<SlotAllocator>::construct(SlotAlloc, Slots + i);
+        }
+        return Slots;
+    }
+
+    static void LoadWords(const Slot& ReadSlot, Word* Words)
+    {
+        for (size_t i = 0; i < m_WordsNum; i++)
+        {
+            Words[i] = ReadSlot.Words[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t LoadMinReadPosition() const
+    {
+        size_t MinReadPosition = m_WritePosition.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < m_SubscribersNum; i++)
+        {
+            MinReadPosition = std::min(MinReadPosition, m_Cursors[i].ReadPosition.load(std::memory_order_acquire));
+        }
+        return MinReadPosition;
+    }
+
+    // The slot of the oldest position may be the one being rewritten, so the subscriber resumes one past it.
+    size_t SkipToOldest(Cursor& SubscriberCursor, size_t ReadPosition)
+    {
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_acquire);
+        const size_t OldestPosition = WritePosition + 1 > m_Capacity ? WritePosition + 1 - m_Capacity : 0;
+        const size_t NewReadPosition = std::max(ReadPosition, OldestPosition);
+        SubscriberCursor.DroppedNum += NewReadPosition - ReadPosition;
+        SubscriberCursor.ReadPosition.store(NewReadPosition, std::memory_order_relaxed);
+        return NewReadPosition;
+    }
+
+private:
+    const size_t m_Capacity;
+    const size_t m_IndexMask;
+    Slot* const m_Slots;
+    const size_t m_SubscribersNum;
+    const std::unique_ptr<Cursor[]> m_Cursors;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WritePosition{ 0 };
+    size_t m_CachedMinReadPosition = 0;
+};
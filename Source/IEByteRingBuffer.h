@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Single-producer single-consumer ring of variable-length records, for messages ranging from a few bytes to several KiB.
+    The producer reserves room for a record, writes its payload in place and commits it, the consumer reads records in place as spans.
+    Each record is prefixed by a small header holding its length and is padded to 8 bytes.
+    A record that doesn't fit before the end of the ring is preceded by a padding record that the consumer skips,
+    so every payload is contiguous in memory and the ring only holds the bytes actually sent.
+    Records are capped at half the ring, so a record plus its padding always fits once the consumer has caught up, wherever the ring wraps.
+*/
+template <typename Allocator = std::allocator<std::byte>>
+class IEByteRingBuffer : private Allocator
+{
+private:
+    struct RecordHeader
+    {
+        uint32_t Size;
+        uint32_t bIsPadding;
+    };
+    static constexpr size_t m_RecordAlignment = 8;
+    static constexpr size_t m_HeaderSize = sizeof(RecordHeader);
+
+public:
+    // Size is rounded up to a power of two, the largest record payload is GetMaxRecordSize().
+    IEByteRingBuffer(size_t Size, const Allocator& BufferAllocator = Allocator()) :
+        Allocator(BufferAllocator),
+        m_Capacity(std::bit_ceil(std::max<size_t>(Size, IE_CACHE_LINE_SIZE))),
+        m_Mask(m_Capacity - 1),
+        m_Data(std::allocator_traits<Allocator>::allocate(*this, m_Capacity + 2 * IE_CACHE_LINE_SIZE))
+    {}
+    IEByteRingBuffer(const IEByteRingBuffer&) = delete;
+    IEByteRingBuffer& operator=(const IEByteRingBuffer&) = delete;
+    ~IEByteRingBuffer()
+    {
+        std::allocator_traits<Allocator>::deallocate(*this, m_Data, m_Capacity + 2 * IE_CACHE_LINE_SIZE);
+    }
+
+public:
+    // Producer side. Returns room for a payload of Size bytes, or std::nullopt if the ring doesn't have that much free space right now.
+    std::optional<std::span<std::byte>> Reserve(size_t Size)
+    {
+        const size_t RecordSize = GetRecordSize(Size);
+        if (IE_UNLIKELY(Size > GetMaxRecordSize()))
+        {
+            return std::nullopt;
+        }
+
+        uint64_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+        const size_t ContiguousSize = m_Capacity - (WritePosition & m_Mask);
+        const size_t PaddingSize = RecordSize > ContiguousSize ? ContiguousSize : 0;
+        if (IE_UNLIKELY(WritePosition + PaddingSize + RecordSize - m_CachedReadPosition > m_Capacity))
+        {
+            m_CachedReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+            if (WritePosition + PaddingSize + RecordSize - m_CachedReadPosition > m_Capacity)
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (PaddingSize != 0)
+        {
+            WriteHeader(WritePosition, RecordHeader{ static_cast<uint32_t>(PaddingSize - m_HeaderSize), 1 });
+            WritePosition += PaddingSize;
+        }
+        m_ReservedPosition = WritePosition;
+        return std::span<std::byte>(GetPayload(WritePosition), Size);
+    }
+
+    // Publishes the last reserved record with a payload of Size bytes, which must not exceed the reserved size.
+    void Commit(size_t Size)
+    {
+        WriteHeader(m_ReservedPosition, RecordHeader{ static_cast<uint32_t>(Size), 0 });
+        m_WritePosition.store(m_ReservedPosition + GetRecordSize(Size), std::memory_order_release);
+    }
+
+    bool Write(std::span<const std::byte> Payload)
+    {
+        std::optional<std::span<std::byte>> Record = Reserve(Payload.size());
+        if (!Record)
+        {
+            return false;
+        }
+        if (!Payload.empty())
+        {
+            std::memcpy(Record->data(), Payload.data(), Payload.size());
+        }
+        Commit(Payload.size());
+        return true;
+    }
+
+    // Consumer side. Returns the payload of the oldest record, which stays valid until Release is called.
+    std::optional<std::span<const std::byte>> Read()
+    {
+        uint64_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            if (IE_UNLIKELY(ReadPosition == m_CachedWritePosition))
+            {
+                m_CachedWritePosition = m_WritePosition.load(std::memory_order_acquire);
+                if (ReadPosition == m_CachedWritePosition)
+                {
+                    return std::nullopt;
+                }
+            }
+
+            const RecordHeader Header = ReadHeader(ReadPosition);
+            if (IE_LIKELY(!Header.bIsPadding))
+            {
+                m_ReadRecordSize = Header.Size;
+                return std::span<const std::byte>(GetPayload(ReadPosition), Header.Size);
+            }
+            ReadPosition += m_HeaderSize + Header.Size;
+            m_ReadPosition.store(ReadPosition, std::memory_order_release);
+        }
+    }
+
+    // Frees the record returned by the last Read.
+    void Release()
+    {
+        m_ReadPosition.store(m_ReadPosition.load(std::memory_order_relaxed) + GetRecordSize(m_ReadRecordSize), std::memory_order_release);
+    }
+
+    bool IsEmpty() const
+    {
+        return m_ReadPosition.load(std::memory_order_acquire) == m_WritePosition.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+    // A larger record could need more padding than the ring holds even while empty, so a retrying producer would never get it in.
+    size_t GetMaxRecordSize() const
+    {
+        return m_Capacity / 2 - m_HeaderSize;
+    }
+
+private:
+    static constexpr size_t GetRecordSize(size_t Size)
+    {
+        return (m_HeaderSize + Size + m_RecordAlignment - 1) / m_RecordAlignment * m_RecordAlignment;
+    }
+
+    std::byte* GetPayload(uint64_t Position) const
+    {
+        return std::to_address(m_Data) + IE_CACHE_LINE_SIZE + (Position & m_Mask) + m_HeaderSize;
+    }
+
+    void WriteHeader(uint64_t Position, const RecordHeader& Header)
+    {
+        std::memcpy(GetPayload(Position) - m_HeaderSize, &Header, m_HeaderSize);
+    }
+
+    RecordHeader ReadHeader(uint64_t Position) const
+    {
+        RecordHeader Header;
+        std::memcpy(&Header, GetPayload(Position) - m_HeaderSize, m_HeaderSize);
+        return Header;
+    }
+
+private:
+    const size_t m_Capacity;
+    const size_t m_Mask;
+    const typename std::allocator_traits<Allocator>::pointer m_Data;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<uint64_t> m_WritePosition{ 0 };
+    uint64_t m_ReservedPosition = 0;
+    uint64_t m_CachedReadPosition = 0;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<uint64_t> m_ReadPosition{ 0 };
+    uint64_t m_CachedWritePosition = 0;
+    uint32_t m_ReadRecordSize = 0;
+};
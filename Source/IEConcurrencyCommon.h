@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdlib>
 #include <memory>
 #include <new>
 #include <optional>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 using size_t = std::size_t;
 
@@ -25,4 +29,33 @@ using size_t = std::size_t;
 #else
     #define IE_LIKELY(x) (x)
     #define IE_UNLIKELY(x) (x)
-#endif
\ No newline at end of file
+#endif
+
+// Lets empty members such as the disabled stats policy take no space.
+#if defined(_MSC_VER)
+    #define IE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+    #define IE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define IE_CPU_RELAX() _mm_pause()
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    #include <intrin.h>
+    #define IE_CPU_RELAX() __yield()
+#elif defined(__x86_64__) || defined(__i386__)
+    #define IE_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+    #define IE_CPU_RELAX() asm volatile("yield")
+#else
+    #define IE_CPU_RELAX() ((void)0)
+#endif
+
+// Small dense index identifying the calling thread, used to spread per-thread state across padded stripes.
+inline size_t IEGetThreadIndex()
+{
+    static std::atomic<size_t> NextThreadIndex{ 0 };
+    thread_local const size_t ThreadIndex = NextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return ThreadIndex;
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+#include <functional>
+
+#include "IEConcurrencyCommon.h"
+#include "IEReadIndicator.h"
+
+/*
+    Open-addressing hash map for read-mostly lookups, with linear probing over a power-of-two table fixed at construction.
+    Each slot keeps its tag, its value pointer and its key inline, so a lookup touches the probed slots and the value only.
+    A key is written once into the slot it claims and never moves, so lookups are wait-free and never retry.
+    Updates swap the slot's value pointer, which is lock-free, and retire the replaced value on a lock-free list.
+    Retired values are freed in batches, once IEReadIndicator shows that no reader which could still see them is left,
+    which is the only time a writer waits for readers. Erasing only clears the value, so keys keep their slot for the map's lifetime.
+*/
+template <typename KeyType, typename MappedType, typename Hasher = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+class IEConcurrentHashMap
+{
+private:
+    struct ValueNode
+    {
+        template <typename... Args>
+        explicit ValueNode(Args&&... _Args) : Value(std::forward<Args>(_Args)...) {}
+
+        const MappedType Value;
+        ValueNode* NextRetired = nullptr;
+    };
+
+    // Tag is 0 while the slot is empty, 1 while its key is being written, and the key's hash with the top bit set once the key is ready.
+    struct Slot
+    {
+        KeyType* GetKey() { return std::launder(reinterpret_cast<KeyType*>(KeyStorage)); }
+        const KeyType* GetKey() const { return std::launder(reinterpret_cast<const KeyType*>(KeyStorage)); }
+
+        std::atomic<size_t> Tag{ 0 };
+        std::atomic<ValueNode*> Value{ nullptr };
+        alignas(KeyType) std::byte KeyStorage[sizeof(KeyType)];
+    };
+
+public:
+    // The table holds twice Size slots rounded up to a power of two, so it stays at most half full with Size keys.
+    explicit IEConcurrentHashMap(size_t Size, size_t ReclaimThreshold = 64) :
+        m_Capacity(std::bit_ceil(std::max<size_t>(Size, 1) * 2)),
+        m_IndexMask(m_Capacity - 1),
+        m_ReclaimThreshold(std::max<size_t>(ReclaimThreshold, 1)),
+        m_Slots(std::make_unique<Slot[]>(m_Capacity))
+    {}
+    IEConcurrentHashMap(const IEConcurrentHashMap&) = delete;
+    IEConcurrentHashMap& operator=(const IEConcurrentHashMap&) = delete;
+    ~IEConcurrentHashMap()
+    {
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            Slot& CurrentSlot = m_Slots[i];
+            if (CurrentSlot.Tag.load(std::memory_order_relaxed) >= m_ReadyBit)
+            {
+                delete CurrentSlot.Value.load(std::memory_order_relaxed);
+                std::destroy_at(CurrentSlot.GetKey());
+            }
+        }
+        DeleteNodes(m_RetiredNodes.load(std::memory_order_relaxed));
+    }
+
+public:
+    // Wait-free. Calls Function(const MappedType&) on the value of Key in place, returns false if Key is absent.
+    template <typename FunctionType>
+    bool Visit(const KeyType& Key, FunctionType&& Function)
+    {
+        const IEReadIndicator::Token ReadToken = m_Readers.Arrive();
+        const ValueNode* Node = FindNode(Key);
+        if (Node)
+        {
+            Function(Node->Value);
+        }
+        m_Readers.Depart(ReadToken);
+        return Node != nullptr;
+    }
+
+    // Wait-free. Returns a copy of the value of Key.
+    std::optional<MappedType> Find(const KeyType& Key)
+    {
+        std::optional<MappedType> Value;
+        Visit(Key, [&](const MappedType& FoundValue) { Value.emplace(FoundValue); });
+        return Value;
+    }
+
+    bool Contains(const KeyType& Key)
+    {
+        return Visit(Key, [](const MappedType&) {});
+    }
+
+    /*
+        Constructs the value of Key from _Args, replacing and retiring the previous value if there is one.
+        Replacing a value is lock-free, while inserting a new key waits for a concurrent insert into the same slot to finish writing its key.
+        Returns false if the table has no slot left for a new key.
+    */
+    template <typename... Args>
+    bool InsertOrAssign(const KeyType& Key, Args&&... _Args)
+    {
+        ValueNode* NewNode = new ValueNode(std::forward<Args>(_Args)...);
+        const size_t Hash = m_Hasher(Key);
+        const size_t Tag = Hash | m_ReadyBit;
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            Slot& CurrentSlot = m_Slots[(Hash + i) & m_IndexMask];
+            size_t SlotTag = CurrentSlot.Tag.load(std::memory_order_acquire);
+            if (SlotTag == m_EmptyTag && CurrentSlot.Tag.compare_exchange_strong(SlotTag, m_ClaimedTag, std::memory_order_acquire))
+            {
+                std::construct_at(CurrentSlot.GetKey(), Key);
+                CurrentSlot.Value.store(NewNode, std::memory_order_relaxed);
+                CurrentSlot.Tag.store(Tag, std::memory_order_release);
+                return true;
+            }
+
+            while (IE_UNLIKELY(SlotTag == m_ClaimedTag))
+            {
+                IE_CPU_RELAX();
+                SlotTag = CurrentSlot.Tag.load(std::memory_order_acquire);
+            }
+            if (SlotTag == Tag && m_KeyEqual(*CurrentSlot.GetKey(), Key))
+            {
+                Retire(CurrentSlot.Value.exchange(NewNode, std::memory_order_seq_cst));
+                return true;
+            }
+        }
+
+        delete NewNode;
+        return false;
+    }
+
+    // Lock-free. Removes the value of Key and retires it, returns false if Key is absent.
+    bool Erase(const KeyType& Key)
+    {
+        Slot* KeySlot = FindSlot(Key);
+        ValueNode* OldNode = KeySlot ? KeySlot->Value.exchange(nullptr, std::memory_order_seq_cst) : nullptr;
+        Retire(OldNode);
+        return OldNode != nullptr;
+    }
+
+    // Frees every retired value, waiting until the readers that could still see them have left.
+    void Reclaim()
+    {
+        if (m_bIsReclaiming.exchange(true, std::memory_order_acquire))
+        {
+            return;
+        }
+
+        ValueNode* RetiredNodes = m_RetiredNodes.exchange(nullptr, std::memory_order_acquire);
+        m_Readers.WaitForReaders();
+        m_RetiredNum.fetch_sub(DeleteNodes(RetiredNodes), std::memory_order_relaxed);
+        m_bIsReclaiming.store(false, std::memory_order_release);
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+private:
+    Slot* FindSlot(const KeyType& Key)
+    {
+        const size_t Hash = m_Hasher(Key);
+        const size_t Tag = Hash | m_ReadyBit;
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            Slot& CurrentSlot = m_Slots[(Hash + i) & m_IndexMask];
+            const size_t SlotTag = CurrentSlot.Tag.load(std::memory_order_acquire);
+            if (SlotTag == m_EmptyTag)
+            {
+                return nullptr;
+            }
+            if (SlotTag == Tag && m_KeyEqual(*CurrentSlot.GetKey(), Key))
+            {
+                return &CurrentSlot;
+            }
+        }
+        return nullptr;
+    }
+
+    // A key still being written is skipped, since its insert has not completed yet.
+    const ValueNode* FindNode(const KeyType& Key)
+    {
+        const Slot* KeySlot = FindSlot(Key);
+        return KeySlot ? KeySlot->Value.load(std::memory_order_seq_cst) : nullptr;
+    }
+
+    void Retire(ValueNode* Node)
+    {
+        if (!Node)
+        {
+            return;
+        }
+
+        ValueNode* Head = m_RetiredNodes.load(std::memory_order_relaxed);
+        do
+        {
+            Node->NextRetired = Head;
+        } while (!m_RetiredNodes.compare_exchange_weak(Head, Node, std::memory_order_release, std::memory_order_relaxed));
+
+        if (m_RetiredNum.fetch_add(1, std::memory_order_relaxed) + 1 >= m_ReclaimThreshold)
+        {
+            Reclaim();
+        }
+    }
+
+    static size_t DeleteNodes(ValueNode* Node)
+    {
+        size_t DeletedNum = 0;
+        while (Node)
+        {
+            ValueNode* NextNode = Node->NextRetired;
+            delete Node;
+            Node = NextNode;
+            DeletedNum++;
+        }
+        return DeletedNum;
+    }
+
+private:
+    static constexpr size_t m_EmptyTag = 0;
+    static constexpr size_t m_ClaimedTag = 1;
+    static constexpr size_t m_ReadyBit = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+    const size_t m_Capacity;
+    const size_t m_IndexMask;
+    const size_t m_ReclaimThreshold;
+    const std::unique_ptr<Slot[]> m_Slots;
+    IE_NO_UNIQUE_ADDRESS Hasher m_Hasher;
+    IE_NO_UNIQUE_ADDRESS KeyEqual m_KeyEqual;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<ValueNode*> m_RetiredNodes{ nullptr };
+    std::atomic<size_t> m_RetiredNum{ 0 };
+    std::atomic<bool> m_bIsReclaiming{ false };
+    IEReadIndicator m_Readers;
+};
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+
+#include "IEConcurrencyCommon.h"
+#include "IEEventCount.h"
+
+/*
+    Single-threaded executor for coroutines suspended on the queues' PopAsync and PushAsync awaiters.
+    Ready tasks are intrusive and type-erased through a function pointer as in IEThreadPool.
+    Any thread may schedule them by pushing onto a lock-free list, which never fills up, so scheduling never waits,
+    even from a task running on the executor's own thread. The thread calling Run takes the whole list at once and executes it in order.
+    Handing work between coroutines running on the same executor therefore never switches threads.
+*/
+class IECoroutineExecutor
+{
+public:
+    struct Task
+    {
+        void (*Execute)(Task&) = nullptr;
+        Task* Next = nullptr;
+    };
+
+    // Fire and forget coroutine type, runs on the calling thread until its first suspension and frees itself once done.
+    struct DetachedCoroutine
+    {
+        struct promise_type
+        {
+            DetachedCoroutine get_return_object() { return DetachedCoroutine{}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+private:
+    struct RescheduleAwaiter : Task
+    {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> InHandle)
+        {
+            Handle = InHandle;
+            Executor.Schedule(*this);
+        }
+        void await_resume() const noexcept {}
+
+        static void Run(Task& Self)
+        {
+            static_cast<RescheduleAwaiter&>(Self).Handle.resume();
+        }
+
+        IECoroutineExecutor& Executor;
+        std::coroutine_handle<> Handle;
+    };
+
+public:
+    IECoroutineExecutor() = default;
+    IECoroutineExecutor(const IECoroutineExecutor&) = delete;
+    IECoroutineExecutor& operator=(const IECoroutineExecutor&) = delete;
+
+public:
+    // Thread safe and never blocks. The task must stay alive until it has been executed, and must not be scheduled again before then.
+    void Schedule(Task& ReadyTask)
+    {
+        Task* Head = m_ReadyTasks.load(std::memory_order_relaxed);
+        do
+        {
+            ReadyTask.Next = Head;
+        } while (!m_ReadyTasks.compare_exchange_weak(Head, &ReadyTask, std::memory_order_seq_cst, std::memory_order_relaxed));
+        m_ReadyEvent.Notify();
+    }
+
+    // co_await Reschedule() resumes the calling coroutine on the executor's thread.
+    RescheduleAwaiter Reschedule()
+    {
+        return RescheduleAwaiter{ { &RescheduleAwaiter::Run }, *this, {} };
+    }
+
+    // Executes the tasks that are ready without blocking, returns how many were executed.
+    size_t RunPending()
+    {
+        size_t ExecutedNum = 0;
+        while (Task* ReadyTask = PopTask())
+        {
+            ReadyTask->Execute(*ReadyTask);
+            ExecutedNum++;
+        }
+        return ExecutedNum;
+    }
+
+    // Executes tasks on the calling thread until Stop is called, parking while none is ready.
+    // Tasks scheduled before Stop still run, and Run can be called again once it has returned.
+    void Run()
+    {
+        Task* ReadyTask = nullptr;
+        bool bHasFoundTask = false;
+        while (true)
+        {
+            m_ReadyEvent.SpinThenWait([&]
+            {
+                ReadyTask = PopTask();
+                bHasFoundTask = ReadyTask != nullptr;
+                return bHasFoundTask || m_bIsStopping.load(std::memory_order_seq_cst);
+            });
+            if (!bHasFoundTask)
+            {
+                break;
+            }
+            ReadyTask->Execute(*ReadyTask);
+        }
+        m_bIsStopping.store(false, std::memory_order_relaxed);
+    }
+
+    // Thread safe, may be called from a task.
+    void Stop()
+    {
+        m_bIsStopping.store(true, std::memory_order_seq_cst);
+        m_ReadyEvent.Notify();
+    }
+
+private:
+    // Executor thread only. Takes the scheduled tasks only once the previous batch has run, reversing them into scheduling order.
+    Task* PopTask()
+    {
+        if (!m_PendingTasks)
+        {
+            Task* ScheduledTask = m_ReadyTasks.exchange(nullptr, std::memory_order_acquire);
+            while (ScheduledTask)
+            {
+                Task* NextTask = ScheduledTask->Next;
+                ScheduledTask->Next = m_PendingTasks;
+                m_PendingTasks = ScheduledTask;
+                ScheduledTask = NextTask;
+            }
+        }
+
+        Task* PendingTask = m_PendingTasks;
+        if (PendingTask)
+        {
+            m_PendingTasks = PendingTask->Next;
+        }
+        return PendingTask;
+    }
+
+private:
+    std::atomic<Task*> m_ReadyTasks{ nullptr };
+    Task* m_PendingTasks = nullptr;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<bool> m_bIsStopping{ false };
+    IEEventCount m_ReadyEvent;
+};
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+    #include <climits>
+    #include <ctime>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Lets threads park until a condition published by another thread becomes true, without locking on the notifying side.
+    Suspended coroutines can wait as well by registering an AsyncWaiter, which Notify hands back through its Resume function.
+    Notify only loads the waiters counter and the coroutine waiters list when nobody waits, both on the same cache line.
+    For this to be race free, the store that makes the condition true must be sequentially consistent
+    (or a read-modify-write) and must happen before calling Notify.
+*/
+class IEEventCount
+{
+public:
+    using Key = uint32_t;
+    static constexpr size_t SpinIterationsNum = 1 << 10;
+
+    // Intrusive node of a suspended coroutine. Resume is called once by the notifying thread, after which the node may be gone.
+    struct AsyncWaiter
+    {
+        void (*Resume)(AsyncWaiter&) = nullptr;
+        AsyncWaiter* Next = nullptr;
+    };
+
+public:
+    IEEventCount() = default;
+    IEEventCount(const IEEventCount&) = delete;
+    IEEventCount& operator=(const IEEventCount&) = delete;
+
+public:
+    void Notify()
+    {
+        if (IE_UNLIKELY(m_WaitersNum.load(std::memory_order_seq_cst) != 0))
+        {
+            m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+            WakeAll();
+        }
+        if (IE_UNLIKELY(m_AsyncWaiters.load(std::memory_order_seq_cst) != nullptr))
+        {
+            ResumeAsyncWaiters();
+        }
+    }
+
+    /*
+        Registers a suspended coroutine. The condition must be re-checked after this call,
+        and if it already became true, Notify must be called so the waiter is not left behind.
+        A waiter cannot be cancelled, so every registration ends with exactly one call to its Resume.
+    */
+    void PrepareAsyncWait(AsyncWaiter& Waiter)
+    {
+        AsyncWaiter* Head = m_AsyncWaiters.load(std::memory_order_relaxed);
+        do
+        {
+            Waiter.Next = Head;
+        } while (!m_AsyncWaiters.compare_exchange_weak(Head, &Waiter, std::memory_order_seq_cst, std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // Registers the caller as a waiter. The condition must be re-checked after this call and before Wait.
+    Key PrepareWait()
+    {
+        m_WaitersNum.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return m_Epoch.load(std::memory_order_acquire);
+    }
+
+    void CancelWait()
+    {
+        m_WaitersNum.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void Wait(Key WaitKey)
+    {
+        while (m_Epoch.load(std::memory_order_acquire) == WaitKey)
+        {
+            WaitOnEpoch(WaitKey);
+        }
+        m_WaitersNum.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Returns false if Deadline passed before a notification.
+    bool WaitUntil(Key WaitKey, std::chrono::steady_clock::time_point Deadline)
+    {
+        bool bNotified = true;
+        while (m_Epoch.load(std::memory_order_acquire) == WaitKey)
+        {
+            if (!WaitOnEpochUntil(WaitKey, Deadline))
+            {
+                bNotified = m_Epoch.load(std::memory_order_acquire) != WaitKey;
+                break;
+            }
+        }
+        m_WaitersNum.fetch_sub(1, std::memory_order_relaxed);
+        return bNotified;
+    }
+
+    // Calls TryFunction until it returns true, spinning briefly before parking between attempts.
+    template <typename TryFunctionType>
+    void SpinThenWait(TryFunctionType&& TryFunction)
+    {
+        for (size_t i = 0; i < SpinIterationsNum; i++)
+        {
+            if (TryFunction())
+            {
+                return;
+            }
+            IE_CPU_RELAX();
+        }
+
+        while (!TryFunction())
+        {
+            const Key WaitKey = PrepareWait();
+            if (TryFunction())
+            {
+                CancelWait();
+                return;
+            }
+            Wait(WaitKey);
+        }
+    }
+
+    // Same as SpinThenWait but gives up once Deadline has passed, returns whether TryFunction succeeded.
+    template <typename TryFunctionType>
+    bool SpinThenWaitUntil(TryFunctionType&& TryFunction, std::chrono::steady_clock::time_point Deadline)
+    {
+        for (size_t i = 0; i < SpinIterationsNum; i++)
+        {
+            if (TryFunction())
+            {
+                return true;
+            }
+            IE_CPU_RELAX();
+        }
+
+        while (!TryFunction())
+        {
+            const Key WaitKey = PrepareWait();
+            if (TryFunction())
+            {
+                CancelWait();
+                return true;
+            }
+            if (!WaitUntil(WaitKey, Deadline))
+            {
+                return TryFunction();
+            }
+        }
+        return true;
+    }
+
+private:
+    // Detaches the whole list at once, so registering and notifying never race on a single node.
+    void ResumeAsyncWaiters()
+    {
+        AsyncWaiter* Waiter = m_AsyncWaiters.exchange(nullptr, std::memory_order_acq_rel);
+        while (Waiter)
+        {
+            AsyncWaiter* NextWaiter = Waiter->Next;
+            Waiter->Resume(*Waiter);
+            Waiter = NextWaiter;
+        }
+    }
+
+#if defined(__linux__)
+    void WaitOnEpoch(Key WaitKey)
+    {
+        syscall(SYS_futex, &m_Epoch, FUTEX_WAIT_PRIVATE, WaitKey, nullptr, nullptr, 0);
+    }
+
+    bool WaitOnEpochUntil(Key WaitKey, std::chrono::steady_clock::time_point Deadline)
+    {
+        // steady_clock is CLOCK_MONOTONIC, which FUTEX_WAIT_BITSET uses for its absolute timeout.
+        const std::chrono::nanoseconds DeadlineTime = Deadline.time_since_epoch();
+        timespec Timeout;
+        Timeout.tv_sec = static_cast<time_t>(std::chrono::duration_cast<std::chrono::seconds>(DeadlineTime).count());
+        Timeout.tv_nsec = static_cast<long>((DeadlineTime - std::chrono::seconds(Timeout.tv_sec)).count());
+        if (std::chrono::steady_clock::now() >= Deadline)
+        {
+            return false;
+        }
+        syscall(SYS_futex, &m_Epoch, FUTEX_WAIT_BITSET_PRIVATE, WaitKey, &Timeout, nullptr, FUTEX_BITSET_MATCH_ANY);
+        return std::chrono::steady_clock::now() < Deadline;
+    }
+
+    void WakeAll()
+    {
+        syscall(SYS_futex, &m_Epoch, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+#else
+    void WaitOnEpoch(Key WaitKey)
+    {
+        m_Epoch.wait(WaitKey, std::memory_order_acquire);
+    }
+
+    // std::atomic::wait has no timeout, so timed waits fall back to short sleeps.
+    bool WaitOnEpochUntil(Key WaitKey, std::chrono::steady_clock::time_point Deadline)
+    {
+        const std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+        if (Now >= Deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(Deadline - Now, std::chrono::microseconds(100)));
+        return true;
+    }
+
+    void WakeAll()
+    {
+        m_Epoch.notify_all();
+    }
+#endif
+
+private:
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<uint32_t> m_Epoch{ 0 };
+    std::atomic<uint32_t> m_WaitersNum{ 0 };
+    std::atomic<AsyncWaiter*> m_AsyncWaiters{ nullptr };
+};
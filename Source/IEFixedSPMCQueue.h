@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+
+#include "IEConcurrencyCommon.h"
+#include "IEStats.h"
+
+/*
+    Single-producer multi-consumer queue with a power-of-two capacity fixed at compile time and its slots stored inline,
+    so the whole queue can live in static or stack storage and be constant-initialized (constinit).
+    Constant initialization requires the storage to be zeroed, which is free in static storage and a one-off cost elsewhere.
+    Slots are handed over with sequence stamps as in IESPMCQueue, positions run freely and are wrapped with a mask.
+    Each stamp is stored relative to its slot index, so that every slot starts at zero:
+    Stamp == Lap means the slot is free for the producer, Stamp == Lap + 1 means its element is ready for a consumer,
+    where Lap is the position with the slot index bits cleared. A single slot could not tell ready from consumed, hence at least two.
+*/
+template <typename T, size_t Capacity, typename Stats = IENoStats>
+requires (std::has_single_bit(Capacity) && Capacity >= 2)
+class IEFixedSPMCQueue
+{
+private:
+    struct Slot
+    {
+        T* GetElement() { return std::launder(reinterpret_cast<T*>(Storage)); }
+
+        std::atomic<size_t> Stamp{ 0 };
+        alignas(T) std::byte Storage[sizeof(T)]{};
+    };
+
+public:
+    using ValueType = T;
+    constexpr IEFixedSPMCQueue() = default;
+    IEFixedSPMCQueue(const IEFixedSPMCQueue&) = delete;
+    IEFixedSPMCQueue& operator=(const IEFixedSPMCQueue&) = delete;
+    ~IEFixedSPMCQueue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+            for (size_t Position = m_ReadPosition.load(std::memory_order_relaxed); Position != WritePosition; Position++)
+            {
+                std::destroy_at(m_Slots[Position & m_IndexMask].GetElement());
+            }
+        }
+    }
+
+    template <typename... Args>
+    bool Push(Args&&... _Args)
+    {
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+        Slot& WriteSlot = m_Slots[WritePosition & m_IndexMask];
+        const size_t Lap = WritePosition & ~m_IndexMask;
+        if (WriteSlot.Stamp.load(std::memory_order_acquire) != Lap)
+        {
+            m_Stats.OnPushFail();
+            return false;
+        }
+
+        std::construct_at(WriteSlot.GetElement(), std::forward<Args>(_Args)...);
+        WriteSlot.Stamp.store(Lap + 1, std::memory_order_release);
+        m_WritePosition.store(WritePosition + 1, std::memory_order_relaxed);
+        if constexpr (Stats::bIsEnabled)
+        {
+            m_Stats.OnSize(WritePosition + 1 - m_ReadPosition.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    bool Pop(T& Element)
+    {
+        size_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& ReadSlot = m_Slots[ReadPosition & m_IndexMask];
+            const size_t Lap = ReadPosition & ~m_IndexMask;
+            const std::ptrdiff_t Difference = static_cast<std::ptrdiff_t>(ReadSlot.Stamp.load(std::memory_order_acquire) - (Lap + 1));
+            if (Difference == 0)
+            {
+                if (m_ReadPosition.compare_exchange_weak(ReadPosition, ReadPosition + 1, std::memory_order_relaxed))
+                {
+                    Element = std::move(*ReadSlot.GetElement());
+                    std::destroy_at(ReadSlot.GetElement());
+                    ReadSlot.Stamp.store(Lap + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                m_Stats.OnPopEmpty();
+                return false;
+            }
+            else
+            {
+                ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+            }
+            m_Stats.OnReadRetry();
+        }
+    }
+
+    std::optional<T> Pop()
+    {
+        T Element;
+        if (Pop(Element))
+        {
+            return std::optional<T>(std::move(Element));
+        }
+        return std::nullopt;
+    }
+
+    bool IsEmpty() const
+    {
+        const size_t ReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+        const size_t Stamp = m_Slots[ReadPosition & m_IndexMask].Stamp.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(Stamp - ((ReadPosition & ~m_IndexMask) + 1)) < 0;
+    }
+
+    bool IsFull() const
+    {
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_acquire);
+        return m_Slots[WritePosition & m_IndexMask].Stamp.load(std::memory_order_acquire) != (WritePosition & ~m_IndexMask);
+    }
+
+    static constexpr size_t GetCapacity()
+    {
+        return Capacity;
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    static constexpr size_t m_IndexMask = Capacity - 1;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WritePosition{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_ReadPosition{ 0 };
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+
+    alignas(IE_CACHE_LINE_SIZE) Slot m_Slots[Capacity];
+};
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+
+#include "IEConcurrencyCommon.h"
+#include "IEStats.h"
+
+/*
+    Single-producer single-consumer queue with a power-of-two capacity fixed at compile time and its ring stored inline,
+    so the whole queue can live in static or stack storage and be constant-initialized (constinit).
+    Constant initialization requires the storage to be zeroed, which is free in static storage and a one-off cost elsewhere.
+    Write and read indices run freely and are wrapped with a mask, which also lets the queue use every slot.
+    As in IESPSCCachedQueue, each side caches the other side's index and only reloads it when the queue appears full or empty.
+*/
+template <typename T, size_t Capacity, typename Stats = IENoStats>
+requires (std::has_single_bit(Capacity))
+class IEFixedSPSCQueue
+{
+public:
+    using ValueType = T;
+    constexpr IEFixedSPSCQueue() = default;
+    IEFixedSPSCQueue(const IEFixedSPSCQueue&) = delete;
+    IEFixedSPSCQueue& operator=(const IEFixedSPSCQueue&) = delete;
+    ~IEFixedSPSCQueue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            const size_t WriteIndex = m_WriteIndex.load(std::memory_order_relaxed);
+            for (size_t Index = m_ReadIndex.load(std::memory_order_relaxed); Index != WriteIndex; Index++)
+            {
+                std::destroy_at(GetElement(Index));
+            }
+        }
+    }
+
+    template <typename... Args>
+    bool Push(Args&&... _Args)
+    {
+        const size_t WriteIndex = m_WriteIndex.load(std::memory_order_relaxed);
+        if (IE_UNLIKELY(WriteIndex - m_CachedReadIndex == Capacity))
+        {
+            m_CachedReadIndex = m_ReadIndex.load(std::memory_order_acquire);
+            if (WriteIndex - m_CachedReadIndex == Capacity)
+            {
+                m_Stats.OnPushFail();
+                return false;
+            }
+        }
+
+        std::construct_at(GetElement(WriteIndex), std::forward<Args>(_Args)...);
+        m_WriteIndex.store(WriteIndex + 1, std::memory_order_release);
+        if constexpr (Stats::bIsEnabled)
+        {
+            m_Stats.OnSize(WriteIndex + 1 - m_ReadIndex.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    bool Pop(T& Element)
+    {
+        const size_t ReadIndex = m_ReadIndex.load(std::memory_order_relaxed);
+        if (IE_UNLIKELY(ReadIndex == m_CachedWriteIndex))
+        {
+            m_CachedWriteIndex = m_WriteIndex.load(std::memory_order_acquire);
+            if (ReadIndex == m_CachedWriteIndex)
+            {
+                m_Stats.OnPopEmpty();
+                return false;
+            }
+        }
+
+        Element = std::move(*GetElement(ReadIndex));
+        std::destroy_at(GetElement(ReadIndex));
+        m_ReadIndex.store(ReadIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> Pop()
+    {
+        T Element;
+        if (Pop(Element))
+        {
+            return std::optional<T>(std::move(Element));
+        }
+        return std::nullopt;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_ReadIndex.load(std::memory_order_acquire) == m_WriteIndex.load(std::memory_order_acquire);
+    }
+
+    bool IsFull() const
+    {
+        return m_WriteIndex.load(std::memory_order_acquire) - m_ReadIndex.load(std::memory_order_acquire) == Capacity;
+    }
+
+    static constexpr size_t GetCapacity()
+    {
+        return Capacity;
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    T* GetElement(size_t Index)
+    {
+        return std::launder(reinterpret_cast<T*>(m_Storage + (Index & m_IndexMask) * sizeof(T)));
+    }
+
+private:
+    static constexpr size_t m_IndexMask = Capacity - 1;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WriteIndex{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) size_t m_CachedReadIndex = 0;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_ReadIndex{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) size_t m_CachedWriteIndex = 0;
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+
+    alignas(IE_CACHE_LINE_SIZE) alignas(T) std::byte m_Storage[Capacity * sizeof(T)]{};
+};
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__linux__)
+    #include <linux/mempolicy.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Allocator for large ring buffers that maps them directly instead of going through the heap.
+    Buffers of at least one huge page are mapped with explicit huge pages when the system has some reserved,
+    and otherwise fall back to regular pages advised for transparent huge pages.
+    The mapping can be bound to a NUMA node, typically the consumer's, and is pre-faulted by default
+    so the first pass over the buffer doesn't page-fault on a real-time thread.
+    On other platforms it behaves like std::allocator.
+*/
+template <typename T>
+class IEHugePageAllocator
+{
+public:
+    using value_type = T;
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+    static constexpr int AnyNumaNode = -1;
+
+public:
+    IEHugePageAllocator() noexcept = default;
+
+    explicit IEHugePageAllocator(int NumaNode, bool bPrefault = true) noexcept :
+        m_NumaNode(NumaNode),
+        m_bPrefault(bPrefault)
+    {}
+
+    template <typename U>
+    IEHugePageAllocator(const IEHugePageAllocator<U>& Other) noexcept :
+        m_NumaNode(Other.GetNumaNode()),
+        m_bPrefault(Other.IsPrefaulting())
+    {}
+
+public:
+#if defined(__linux__)
+    T* allocate(size_t Num)
+    {
+        const size_t MappingSize = GetMappingSize(Num);
+        void* Mapping = MAP_FAILED;
+        if (MappingSize >= HugePageSize)
+        {
+            Mapping = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (Mapping == MAP_FAILED)
+        {
+            Mapping = MapTransparentHugePages(MappingSize);
+        }
+
+        if (m_NumaNode >= 0)
+        {
+            // Preferred rather than strict binding, so an exhausted node degrades to remote memory instead of failing.
+            // The mask grows with the node index, and the kernel ignores the last bit of maxnode, hence the extra one.
+            constexpr size_t BitsPerWord = sizeof(unsigned long) * 8;
+            std::vector<unsigned long> NodeMask(m_NumaNode / BitsPerWord + 1, 0);
+            NodeMask[m_NumaNode / BitsPerWord] = 1ul << (m_NumaNode % BitsPerWord);
+            syscall(SYS_mbind, Mapping, MappingSize, MPOL_PREFERRED, NodeMask.data(), NodeMask.size() * BitsPerWord + 1, 0);
+        }
+
+        if (m_bPrefault)
+        {
+            volatile std::byte* Bytes = static_cast<std::byte*>(Mapping);
+            for (size_t Offset = 0; Offset < MappingSize; Offset += GetPageSize())
+            {
+                Bytes[Offset] = std::byte{ 0 };
+            }
+        }
+        return static_cast<T*>(Mapping);
+    }
+
+    void deallocate(T* Pointer, size_t Num)
+    {
+        munmap(Pointer, GetMappingSize(Num));
+    }
+
+    // NUMA node of the CPU the calling thread currently runs on, or AnyNumaNode if it can't be determined.
+    static int GetCurrentNumaNode()
+    {
+        unsigned int Cpu = 0, Node = 0;
+        return syscall(SYS_getcpu, &Cpu, &Node, nullptr) == 0 ? static_cast<int>(Node) : AnyNumaNode;
+    }
+#else
+    T* allocate(size_t Num)
+    {
+        return std::allocator<T>().allocate(Num);
+    }
+
+    void deallocate(T* Pointer, size_t Num)
+    {
+        std::allocator<T>().deallocate(Pointer, Num);
+    }
+
+    static int GetCurrentNumaNode()
+    {
+        return AnyNumaNode;
+    }
+#endif
+
+    int GetNumaNode() const
+    {
+        return m_NumaNode;
+    }
+
+    bool IsPrefaulting() const
+    {
+        return m_bPrefault;
+    }
+
+    template <typename U>
+    bool operator==(const IEHugePageAllocator<U>&) const noexcept
+    {
+        // Any instance can release any mapping.
+        return true;
+    }
+
+private:
+#if defined(__linux__)
+    static size_t GetPageSize()
+    {
+        static const size_t PageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return PageSize;
+    }
+
+    // Over-maps by one huge page and trims both ends so the mapping is huge page aligned and can be fully backed by them.
+    static void* MapTransparentHugePages(size_t MappingSize)
+    {
+        const size_t Alignment = MappingSize >= HugePageSize ? HugePageSize : GetPageSize();
+        const size_t PaddedSize = MappingSize + Alignment - GetPageSize();
+        void* PaddedMapping = mmap(nullptr, PaddedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (PaddedMapping == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        const uintptr_t PaddedAddress = reinterpret_cast<uintptr_t>(PaddedMapping);
+        const uintptr_t Address = (PaddedAddress + Alignment - 1) / Alignment * Alignment;
+        if (Address > PaddedAddress)
+        {
+            munmap(PaddedMapping, Address - PaddedAddress);
+        }
+        if (Address + MappingSize < PaddedAddress + PaddedSize)
+        {
+            munmap(reinterpret_cast<void*>(Address + MappingSize), PaddedAddress + PaddedSize - Address - MappingSize);
+        }
+
+        void* Mapping = reinterpret_cast<void*>(Address);
+        if (MappingSize >= HugePageSize)
+        {
+            madvise(Mapping, MappingSize, MADV_HUGEPAGE);
+        }
+        return Mapping;
+    }
+
+    static size_t GetMappingSize(size_t Num)
+    {
+        const size_t Size = Num * sizeof(T);
+        const size_t Alignment = Size >= HugePageSize ? HugePageSize : GetPageSize();
+        return (Size + Alignment - 1) / Alignment * Alignment;
+    }
+#endif
+
+private:
+    int m_NumaNode = AnyNumaNode;
+    bool m_bPrefault = true;
+};
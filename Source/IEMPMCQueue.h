@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IEConcurrencyCommon.h"
+#include "IEStats.h"
+
+/*
+    Every slot carries a sequence stamp telling whose turn it is on the slot:
+    Sequence == Position means the slot is free for the producer claiming Position,
+    Sequence == Position + 1 means the element at Position is ready for the consumer claiming Position.
+    Producers and consumers claim positions with a CAS on their respective positions, so neither side holds a lock.
+*/
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = IENoStats>
+class IEMPMCQueue : private Allocator
+{
+private:
+    struct Slot
+    {
+        explicit Slot(size_t InitialSequence) : Sequence(InitialSequence) {}
+        T* GetElement() { return std::launder(reinterpret_cast<T*>(Storage)); }
+
+        std::atomic<size_t> Sequence;
+        alignas(T) std::byte Storage[sizeof(T)];
+    };
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+public:
+    using ValueType = T;
+    IEMPMCQueue(size_t Size, const Allocator& QueueAllocator = Allocator()) :
+        Allocator(QueueAllocator),
+        m_Capacity(Size + 1),
+        m_Slots(AllocateSlots())
+    {}
+    IEMPMCQueue(const IEMPMCQueue&) = delete;
+    IEMPMCQueue& operator=(const IEMPMCQueue&) = delete;
+    ~IEMPMCQueue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+            for (size_t Position = m_ReadPosition.load(std::memory_order_relaxed); Position != WritePosition; Position++)
+            {
+                std::allocator_traits<Allocator>::destroy(*this, GetSlot(Position).GetElement());
+            }
+        }
+        SlotAllocator SlotAlloc(*this);
+        std::allocator_traits<SlotAllocator>::deallocate(SlotAlloc, m_Slots, m_Capacity + 2 * m_PaddingSlotsNum);
+    }
+
+    template <typename... Args>
+    bool Push(Args&&... _Args)
+    {
+        size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& WriteSlot = GetSlot(WritePosition);
+            const std::ptrdiff_t Difference = static_cast<std::ptrdiff_t>(WriteSlot.Sequence.load(std::memory_order_acquire) - WritePosition);
+            if (Difference == 0)
+            {
+                if (m_WritePosition.compare_exchange_weak(WritePosition, WritePosition + 1, std::memory_order_relaxed))
+                {
+                    std::allocator_traits<Allocator>::construct(*this, WriteSlot.GetElement(), std::forward<Args>(_Args)...);
+                    WriteSlot.Sequence.store(WritePosition + 1, std::memory_order_release);
+                    if constexpr (Stats::bIsEnabled)
+                    {
+                        const size_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+                        m_Stats.OnSize(WritePosition + 1 > ReadPosition ? WritePosition + 1 - ReadPosition : 0);
+                    }
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                m_Stats.OnPushFail();
+                return false;
+            }
+            else
+            {
+                WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+            }
+            m_Stats.OnWriteRetry();
+        }
+    }
+
+    bool Pop(T& Element)
+    {
+        size_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& ReadSlot = GetSlot(ReadPosition);
+            const std::ptrdiff_t Difference = static_cast<std::ptrdiff_t>(ReadSlot.Sequence.load(std::memory_order_acquire) - (ReadPosition + 1));
+            if (Difference == 0)
+            {
+                if (m_ReadPosition.compare_exchange_weak(ReadPosition, ReadPosition + 1, std::memory_order_relaxed))
+                {
+                    Element = std::move(*ReadSlot.GetElement());
+                    std::allocator_traits<Allocator>::destroy(*this, ReadSlot.GetElement());
+                    ReadSlot.Sequence.store(ReadPosition + m_Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                m_Stats.OnPopEmpty();
+                return false;
+            }
+            else
+            {
+                ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+            }
+            m_Stats.OnReadRetry();
+        }
+    }
+
+    std::optional<T> Pop()
+    {
+        T Element;
+        if (Pop(Element))
+        {
+            return std::optional<T>(std::move(Element));
+        }
+        return std::nullopt;
+    }
+
+    bool IsEmpty() const
+    {
+        const size_t ReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+        const size_t Sequence = GetSlot(ReadPosition).Sequence.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(Sequence - (ReadPosition + 1)) < 0;
+    }
+
+    bool IsFull() const
+    {
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_acquire);
+        const size_t Sequence = GetSlot(WritePosition).Sequence.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(Sequence - WritePosition) < 0;
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    Slot* AllocateSlots()
+    {
+        SlotAllocator SlotAlloc(*this);
+        Slot* Slots = std::allocator_traits<SlotAllocator>::allocate(SlotAlloc, m_Capacity + 2 * m_PaddingSlotsNum);
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            std::allocator_traits<SlotAllocator>::construct(SlotAlloc, Slots + m_PaddingSlotsNum + i, i);
+        }
+        return Slots;
+    }
+
+    Slot& GetSlot(size_t Position) const
+    {
+        return m_Slots[Position % m_Capacity + m_PaddingSlotsNum];
+    }
+
+private:
+    static constexpr size_t m_PaddingSlotsNum = (IE_CACHE_LINE_SIZE - 1) / sizeof(Slot) + 1;
+    const size_t m_Capacity;
+    Slot* const m_Slots;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WritePosition{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_ReadPosition{ 0 };
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+};
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IEBlockPool.h"
+#include "IEConcurrencyCommon.h"
+
+// One process-wide pool per BlockSize and BlocksNum, shared by every element type.
+template <size_t BlockSize, size_t BlocksNum>
+IEBlockPool& IEGetDefaultBlockPool()
+{
+    static IEBlockPool DefaultPool(BlockSize, BlocksNum);
+    return DefaultPool;
+}
+
+/*
+    Standard allocator serving single objects of up to BlockSize bytes from an IEBlockPool,
+    so objects allocated on one thread and freed on another never touch the global heap.
+    Requests that don't fit a block, or arrive while the pool is exhausted, fall back to std::allocator.
+    Default constructed allocators share one process-wide pool of BlocksNum blocks per BlockSize, whatever their element type.
+    It is meant for node-based users allocating one object at a time, such as IESpinOnWriteObject's heap versions.
+    The queues allocate their whole ring at once, which never fits a block, so they always take the std::allocator path.
+*/
+template <typename T, size_t BlockSize = 64, size_t BlocksNum = 1 << 16>
+class IEPoolAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = IEPoolAllocator<U, BlockSize, BlocksNum>;
+    };
+
+public:
+    IEPoolAllocator() noexcept :
+        m_Pool(&GetDefaultPool())
+    {}
+
+    explicit IEPoolAllocator(IEBlockPool& Pool) noexcept :
+        m_Pool(&Pool)
+    {}
+
+    template <typename U>
+    IEPoolAllocator(const IEPoolAllocator<U, BlockSize, BlocksNum>& Other) noexcept :
+        m_Pool(&Other.GetPool())
+    {}
+
+public:
+    T* allocate(size_t Num)
+    {
+        if (Num * sizeof(T) <= m_Pool->GetBlockSize() && alignof(T) <= IEBlockPool::BlockAlignment)
+        {
+            if (void* Block = m_Pool->Allocate())
+            {
+                return static_cast<T*>(Block);
+            }
+        }
+        return std::allocator<T>().allocate(Num);
+    }
+
+    void deallocate(T* Pointer, size_t Num)
+    {
+        if (m_Pool->Owns(Pointer))
+        {
+            m_Pool->Deallocate(Pointer);
+        }
+        else
+        {
+            std::allocator<T>().deallocate(Pointer, Num);
+        }
+    }
+
+    IEBlockPool& GetPool() const
+    {
+        return *m_Pool;
+    }
+
+    static IEBlockPool& GetDefaultPool()
+    {
+        return IEGetDefaultBlockPool<BlockSize, BlocksNum>();
+    }
+
+    template <typename U>
+    bool operator==(const IEPoolAllocator<U, BlockSize, BlocksNum>& Other) const noexcept
+    {
+        return m_Pool == &Other.GetPool();
+    }
+
+private:
+    IEBlockPool* m_Pool;
+};
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <coroutine>
+#include <optional>
+
+#include "IEConcurrencyCommon.h"
+#include "IECoroutineExecutor.h"
+#include "IEEventCount.h"
+
+/*
+    Awaiters returned by the queues' PopAsync and PushAsync.
+    The operation is first tried inline, so a coroutine only suspends when the queue is empty (or full).
+    A suspended awaiter registers itself on the queue's event count, the notifying thread only schedules it on the executor,
+    and the executor retries the operation, resuming the coroutine on success and registering again otherwise.
+    Once registered, the awaiter may be resumed and destroyed by the executor's thread at any point, hence the local copies in Wait.
+*/
+template <typename QueueType>
+class IEPopAwaiter : private IEEventCount::AsyncWaiter, private IECoroutineExecutor::Task
+{
+public:
+    using T = typename QueueType::ValueType;
+    IEPopAwaiter(QueueType& Queue, IEEventCount& NotEmptyEvent, IECoroutineExecutor& Executor) :
+        AsyncWaiter{ &IEPopAwaiter::OnNotified },
+        Task{ &IEPopAwaiter::Run },
+        m_Queue(Queue),
+        m_NotEmptyEvent(NotEmptyEvent),
+        m_Executor(Executor)
+    {}
+    IEPopAwaiter(const IEPopAwaiter&) = delete;
+    IEPopAwaiter& operator=(const IEPopAwaiter&) = delete;
+
+public:
+    bool await_ready()
+    {
+        m_Element = m_Queue.Pop();
+        return m_Element.has_value();
+    }
+
+    void await_suspend(std::coroutine_handle<> Handle)
+    {
+        m_Handle = Handle;
+        Wait();
+    }
+
+    T await_resume()
+    {
+        return std::move(*m_Element);
+    }
+
+private:
+    void Wait()
+    {
+        QueueType& Queue = m_Queue;
+        IEEventCount& NotEmptyEvent = m_NotEmptyEvent;
+        NotEmptyEvent.PrepareAsyncWait(*this);
+        if (!Queue.IsEmpty())
+        {
+            NotEmptyEvent.Notify();
+        }
+    }
+
+    static void OnNotified(AsyncWaiter& Waiter)
+    {
+        IEPopAwaiter& This = static_cast<IEPopAwaiter&>(Waiter);
+        This.m_Executor.Schedule(static_cast<Task&>(This));
+    }
+
+    static void Run(Task& Self)
+    {
+        IEPopAwaiter& This = static_cast<IEPopAwaiter&>(Self);
+        This.m_Element = This.m_Queue.Pop();
+        if (This.m_Element)
+        {
+            This.m_Handle.resume();
+        }
+        else
+        {
+            This.Wait();
+        }
+    }
+
+private:
+    QueueType& m_Queue;
+    IEEventCount& m_NotEmptyEvent;
+    IECoroutineExecutor& m_Executor;
+    std::coroutine_handle<> m_Handle;
+    std::optional<T> m_Element;
+};
+
+template <typename QueueType>
+class IEPushAwaiter : private IEEventCount::AsyncWaiter, private IECoroutineExecutor::Task
+{
+public:
+    using T = typename QueueType::ValueType;
+    IEPushAwaiter(QueueType& Queue, IEEventCount& NotFullEvent, IECoroutineExecutor& Executor, T&& Element) :
+        AsyncWaiter{ &IEPushAwaiter::OnNotified },
+        Task{ &IEPushAwaiter::Run },
+        m_Queue(Queue),
+        m_NotFullEvent(NotFullEvent),
+        m_Executor(Executor),
+        m_Element(std::move(Element))
+    {}
+    IEPushAwaiter(const IEPushAwaiter&) = delete;
+    IEPushAwaiter& operator=(const IEPushAwaiter&) = delete;
+
+public:
+    bool await_ready()
+    {
+        return m_Queue.Push(std::move(m_Element));
+    }
+
+    void await_suspend(std::coroutine_handle<> Handle)
+    {
+        m_Handle = Handle;
+        Wait();
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    void Wait()
+    {
+        QueueType& Queue = m_Queue;
+        IEEventCount& NotFullEvent = m_NotFullEvent;
+        NotFullEvent.PrepareAsyncWait(*this);
+        if (!Queue.IsFull())
+        {
+            NotFullEvent.Notify();
+        }
+    }
+
+    static void OnNotified(AsyncWaiter& Waiter)
+    {
+        IEPushAwaiter& This = static_cast<IEPushAwaiter&>(Waiter);
+        This.m_Executor.Schedule(static_cast<Task&>(This));
+    }
+
+    static void Run(Task& Self)
+    {
+        IEPushAwaiter& This = static_cast<IEPushAwaiter&>(Self);
+        if (This.m_Queue.Push(std::move(This.m_Element)))
+        {
+            This.m_Handle.resume();
+        }
+        else
+        {
+            This.Wait();
+        }
+    }
+
+private:
+    QueueType& m_Queue;
+    IEEventCount& m_NotFullEvent;
+    IECoroutineExecutor& m_Executor;
+    std::coroutine_handle<> m_Handle;
+    T m_Element;
+};
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "IEConcurrencyCommon.h"
+#include "IEEventCount.h"
+#include "IESPSCQueue.h"
+
+/*
+    Fan-in of many single-producer queues, one per producer, into a single consumer.
+    A ready bitmap tells the consumer which queues may hold elements, so draining never scans empty queues.
+    A producer only sets its bit when it finds it clear, which happens once per consumer visit rather than once per push,
+    and the consumer clears a whole word of bits with one exchange before draining the queues it found ready.
+    Every ready queue is drained of at most BatchQuota elements per pass, and a queue left non-empty is marked ready again,
+    so a busy producer cannot starve the others. Passes start from a rotating word of the bitmap.
+    QueueType's Push must publish with a sequentially consistent store or read-modify-write, as IESPSCQueue and IESPMCQueue do.
+    On the consumer side, a sequentially consistent fence between clearing a word and popping its queues pairs with that,
+    so either the consumer sees the element or the producer sees its bit cleared and sets it again.
+*/
+template <typename T, typename QueueType = IESPSCQueue<T>>
+class IEQueueSelector
+{
+private:
+    static constexpr size_t m_BitsPerWord = 64;
+
+    struct alignas(IE_CACHE_LINE_SIZE) ReadyWord
+    {
+        std::atomic<uint64_t> Bits{ 0 };
+    };
+
+public:
+    using ValueType = T;
+    IEQueueSelector(size_t QueuesNum, size_t QueueSize, size_t BatchQuota = 32) :
+        m_BatchQuota(std::max<size_t>(BatchQuota, 1)),
+        m_WordsNum((QueuesNum + m_BitsPerWord - 1) / m_BitsPerWord),
+        m_ReadyWords(std::make_unique<ReadyWord[]>(m_WordsNum))
+    {
+        m_Queues.reserve(QueuesNum);
+        for (size_t i = 0; i < QueuesNum; i++)
+        {
+            m_Queues.emplace_back(std::make_unique<QueueType>(QueueSize));
+        }
+    }
+    IEQueueSelector(const IEQueueSelector&) = delete;
+    IEQueueSelector& operator=(const IEQueueSelector&) = delete;
+
+public:
+    // Producer of QueueIndex only.
+    template <typename... Args>
+    bool Push(size_t QueueIndex, Args&&... _Args)
+    {
+        if (!m_Queues[QueueIndex]->Push(std::forward<Args>(_Args)...))
+        {
+            return false;
+        }
+
+        ReadyWord& Word = m_ReadyWords[QueueIndex / m_BitsPerWord];
+        const uint64_t Bit = uint64_t(1) << (QueueIndex % m_BitsPerWord);
+        if (!(Word.Bits.load(std::memory_order_seq_cst) & Bit))
+        {
+            Word.Bits.fetch_or(Bit, std::memory_order_seq_cst);
+            m_ReadyEvent.Notify();
+        }
+        return true;
+    }
+
+    // Consumer only. Makes one pass over the ready queues, calling Function(QueueIndex, Element) on every popped element.
+    // Returns the number of elements popped.
+    template <typename FunctionType>
+    size_t Drain(FunctionType&& Function)
+    {
+        size_t PoppedNum = 0;
+        T Element;
+        for (size_t i = 0; i < m_WordsNum; i++)
+        {
+            const size_t WordIndex = m_FirstWordIndex + i < m_WordsNum ? m_FirstWordIndex + i : m_FirstWordIndex + i - m_WordsNum;
+            ReadyWord& Word = m_ReadyWords[WordIndex];
+            if (Word.Bits.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+
+            uint64_t ReadyBits = Word.Bits.exchange(0, std::memory_order_seq_cst);
+            // The queues' Pop only acquires, which could otherwise be ordered before the exchange.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (ReadyBits)
+            {
+                const size_t QueueIndex = WordIndex * m_BitsPerWord + std::countr_zero(ReadyBits);
+                ReadyBits &= ReadyBits - 1;
+
+                QueueType& Queue = *m_Queues[QueueIndex];
+                size_t QueuePoppedNum = 0;
+                while (QueuePoppedNum < m_BatchQuota && Queue.Pop(Element))
+                {
+                    Function(QueueIndex, Element);
+                    QueuePoppedNum++;
+                }
+                if (QueuePoppedNum == m_BatchQuota && !Queue.IsEmpty())
+                {
+                    Word.Bits.fetch_or(uint64_t(1) << (QueueIndex % m_BitsPerWord), std::memory_order_relaxed);
+                }
+                PoppedNum += QueuePoppedNum;
+            }
+        }
+        m_FirstWordIndex = m_FirstWordIndex + 1 < m_WordsNum ? m_FirstWordIndex + 1 : 0;
+        return PoppedNum;
+    }
+
+    // Consumer only. Same as Drain but spins briefly and then parks until at least one element was popped.
+    template <typename FunctionType>
+    size_t DrainWait(FunctionType&& Function)
+    {
+        size_t PoppedNum = 0;
+        m_ReadyEvent.SpinThenWait([&]
+        {
+            PoppedNum = Drain(Function);
+            return PoppedNum != 0;
+        });
+        return PoppedNum;
+    }
+
+    // A queue drained by another pass may still be marked ready, so this can report false for an empty selector, never the opposite.
+    bool IsEmpty() const
+    {
+        for (size_t i = 0; i < m_WordsNum; i++)
+        {
+            if (m_ReadyWords[i].Bits.load(std::memory_order_acquire) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t GetQueuesNum() const
+    {
+        return m_Queues.size();
+    }
+
+    size_t GetBatchQuota() const
+    {
+        return m_BatchQuota;
+    }
+
+private:
+    const size_t m_BatchQuota;
+    const size_t m_WordsNum;
+    std::vector<std::unique_ptr<QueueType>> m_Queues;
+    const std::unique_ptr<ReadyWord[]> m_ReadyWords;
+    size_t m_FirstWordIndex = 0;
+
+    IEEventCount m_ReadyEvent;
+};
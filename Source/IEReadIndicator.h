@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <thread>
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Tracks readers of shared data so a writer can tell when every reader that may still see an old version has left.
+    Readers arrive and depart on padded per-thread stripes of one of two epochs, which is wait-free and spreads contention.
+    A writer unpublishes the old version first and then calls WaitForReaders, which drains the previous epoch,
+    flips the epoch and drains the current one, so readers arriving meanwhile can never starve it.
+*/
+class IEReadIndicator
+{
+public:
+    using Token = size_t;
+    static constexpr size_t StripesNum = 16;
+
+public:
+    IEReadIndicator() = default;
+    IEReadIndicator(const IEReadIndicator&) = delete;
+    IEReadIndicator& operator=(const IEReadIndicator&) = delete;
+
+public:
+    Token Arrive()
+    {
+        const size_t Epoch = m_Epoch.load(std::memory_order_seq_cst) & 1;
+        const size_t Stripe = IEGetThreadIndex() % StripesNum;
+        m_Readers[Epoch][Stripe].Num.fetch_add(1, std::memory_order_seq_cst);
+        return Epoch * StripesNum + Stripe;
+    }
+
+    void Depart(Token ReadToken)
+    {
+        m_Readers[ReadToken / StripesNum][ReadToken % StripesNum].Num.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Writer side, concurrent writers must be serialized by the caller.
+    void WaitForReaders()
+    {
+        const size_t Epoch = m_Epoch.load(std::memory_order_seq_cst) & 1;
+        WaitForEpoch(Epoch ^ 1);
+        m_Epoch.store(Epoch ^ 1, std::memory_order_seq_cst);
+        WaitForEpoch(Epoch);
+    }
+
+private:
+    void WaitForEpoch(size_t Epoch) const
+    {
+        for (const ReaderCounter& Counter : m_Readers[Epoch])
+        {
+            for (size_t SpinCount = 0; Counter.Num.load(std::memory_order_seq_cst) != 0; SpinCount++)
+            {
+                if (IE_UNLIKELY(SpinCount >= m_SpinIterationsNum))
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    IE_CPU_RELAX();
+                }
+            }
+        }
+    }
+
+private:
+    struct alignas(IE_CACHE_LINE_SIZE) ReaderCounter
+    {
+        std::atomic<size_t> Num{ 0 };
+    };
+
+    static constexpr size_t m_SpinIterationsNum = 1 << 10;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_Epoch{ 0 };
+    ReaderCounter m_Readers[2][StripesNum];
+};
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IEConcurrencyCommon.h"
+#include "IEReadIndicator.h"
+#include "IEStats.h"
+
+/*
+    Read-mostly variant of IESpinOnWriteObject where any number of readers may hold the object at the same time.
+    Readers obtain a stable reference wait-free, the writer publishes a new version
+    and spins until every reader that could still see the previous version has released it before freeing it.
+*/
+template<typename T, typename Stats = IENoStats>
+class IEReadMostlyObject
+{
+public:
+    explicit IEReadMostlyObject(const T& ObjectValue = T()) :
+        m_Object(new T(ObjectValue))
+    {
+    }
+
+    ~IEReadMostlyObject()
+    {
+        delete m_Object.load(std::memory_order_relaxed);
+    }
+
+    IEReadMostlyObject(const IEReadMostlyObject&) = delete;
+    IEReadMostlyObject& operator=(const IEReadMostlyObject&) = delete;
+
+private:
+    class ScopedLock
+    {
+    private:
+        explicit ScopedLock(IEReadMostlyObject& ReadMostlyObject) :
+            m_ReadMostlyObject(ReadMostlyObject),
+            m_ReadLockToken(ReadMostlyObject.m_Stats.BeginReadLock()),
+            m_ReadToken(ReadMostlyObject.m_Readers.Arrive())
+        {
+        }
+        ~ScopedLock()
+        {
+            m_ReadMostlyObject.m_Readers.Depart(m_ReadToken);
+            m_ReadMostlyObject.m_Stats.EndReadLock(m_ReadLockToken);
+        }
+
+        ScopedLock(ScopedLock&&) = delete;
+        ScopedLock(const ScopedLock&) = delete;
+        ScopedLock& operator=(const ScopedLock&) = delete;
+
+    private:
+        IEReadMostlyObject& m_ReadMostlyObject;
+        IE_NO_UNIQUE_ADDRESS const typename Stats::ReadLockToken m_ReadLockToken;
+        const IEReadIndicator::Token m_ReadToken;
+        friend class IEReadMostlyObject;
+    };
+
+public:
+    struct LockedValue
+    {
+        const IEReadMostlyObject::ScopedLock ScopedLock;
+        const T& Value;
+    };
+
+public:
+    const LockedValue LockForRead()
+    {
+        return LockedValue{ IEReadMostlyObject::ScopedLock(*this), *m_Object.load(std::memory_order_seq_cst) };
+    }
+
+    void Write(const T& NewObject)
+    {
+        std::unique_ptr<const T> NewObjectStorage = std::make_unique<T>(NewObject);
+        while (m_bIsWriting.exchange(true, std::memory_order_acquire))
+        {
+            m_Stats.OnWriteRetry();
+            IE_CPU_RELAX();
+        }
+
+        std::unique_ptr<const T> OldObjectStorage(m_Object.exchange(NewObjectStorage.release(), std::memory_order_seq_cst));
+        m_Readers.WaitForReaders();
+        m_bIsWriting.store(false, std::memory_order_release);
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<const T*> m_Object;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<bool> m_bIsWriting{ false };
+    IEReadIndicator m_Readers;
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+};
@@ -5,15 +5,37 @@
 #pragma once
 
 #include "IEConcurrencyCommon.h"
+#include "IEEventCount.h"
+#include "IEQueueAwaiter.h"
+#include "IEStats.h"
 
-template <typename T, typename Allocator = std::allocator<T>>
+/*
+    Every slot carries a sequence stamp telling whose turn it is on the slot:
+    Sequence == Position means the slot is free for the producer writing Position,
+    Sequence == Position + 1 means the element at Position is ready for a consumer.
+    Consumers claim positions independently with a CAS on the read position, so they never wait on each other.
+    Stamps are published with sequentially consistent stores so the blocking variants cannot miss a wake-up.
+*/
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = IENoStats>
 class IESPMCQueue : private Allocator
 {
+private:
+    struct Slot
+    {
+        explicit Slot(size_t InitialSequence) : Sequence(InitialSequence) {}
+        T* GetElement() { return std::launder(reinterpret_cast<T*>(Storage)); }
+
+        std::atomic<size_t> Sequence;
+        alignas(T) std::byte Storage[sizeof(T)];
+    };
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
 public:
     using ValueType = T;
-    IESPMCQueue(size_t Size) : 
+    IESPMCQueue(size_t Size, const Allocator& QueueAllocator = Allocator()) :
+        Allocator(QueueAllocator),
         m_Capacity(Size + 1),
-        m_Data(std::allocator_traits<Allocator>::allocate(*this, m_Capacity + 2 * m_PaddingElementsNum))
+        m_Slots(AllocateSlots())
     {}
     IESPMCQueue(const IESPMCQueue&) = delete;
     IESPMCQueue& operator=(const IESPMCQueue&) = delete;
@@ -21,66 +43,130 @@ public:
     {
         if constexpr (!std::is_trivially_destructible_v<T>)
         {
-            for (std::size_t i = 0; i < m_Num.load(std::memory_order_relaxed); i++)
+            const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+            for (size_t Position = m_ReadPosition.load(std::memory_order_relaxed); Position != WritePosition; Position++)
             {
-                std::allocator_traits<Allocator>::destroy(*this, m_Data + m_PaddingElementsNum + i);
+                std::allocator_traits<Allocator>::destroy(*this, GetSlot(Position).GetElement());
             }
         }
-        std::allocator_traits<Allocator>::deallocate(*this, m_Data, m_Capacity + 2 * m_PaddingElementsNum);
+        SlotAllocator SlotAlloc(*this);
+        std::allocator_traits<SlotAllocator>::deallocate(SlotAlloc, m_Slots, m_Capacity + 2 * m_PaddingSlotsNum);
     }
 
     template <typename... Args>
     bool Push(Args&&... _Args)
     {
-        if (m_Num.load(std::memory_order_acquire) >= m_Capacity)
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+        Slot& WriteSlot = m_Slots[m_WriteIndex + m_PaddingSlotsNum];
+        if (WriteSlot.Sequence.load(std::memory_order_acquire) != WritePosition)
         {
+            m_Stats.OnPushFail();
             return false;
         }
 
-        std::allocator_traits<Allocator>::construct(*this, m_Data + m_WriteIndex + m_PaddingElementsNum, std::forward<Args>(_Args)...);
-        m_WriteIndex = IE_UNLIKELY(m_WriteIndex == m_Capacity) ? 0 : m_WriteIndex + 1;
-        m_Num.fetch_add(1, std::memory_order_release);
+        std::allocator_traits<Allocator>::construct(*this, WriteSlot.GetElement(), std::forward<Args>(_Args)...);
+        WriteSlot.Sequence.store(WritePosition + 1, std::memory_order_seq_cst);
+        m_WriteIndex = IE_UNLIKELY(m_WriteIndex + 1 == m_Capacity) ? 0 : m_WriteIndex + 1;
+        m_WritePosition.store(WritePosition + 1, std::memory_order_relaxed);
+        if constexpr (Stats::bIsEnabled)
+        {
+            m_Stats.OnSize(WritePosition + 1 - m_ReadPosition.load(std::memory_order_relaxed));
+        }
+        m_NotEmptyEvent.Notify();
         return true;
     }
 
     bool Pop(T& Element)
     {
-        if (m_Num.load(std::memory_order_acquire) == 0)
-        {
-            return false;
-        }
+        return Consume([&](T& FrontElement) { Element = std::move(FrontElement); });
+    }
 
-        bool bIsReading = false;
-        while (!m_bIsReading.compare_exchange_weak(bIsReading, true))
+    // Move-constructs the element straight into the optional, so T needs no default constructor.
+    std::optional<T> Pop()
+    {
+        std::optional<T> Element;
+        Consume([&](T& FrontElement) { Element.emplace(std::move(FrontElement)); });
+        return Element;
+    }
+
+    /*
+        Claims the oldest element, calls Function(T&) on it in place and then destroys it, returns false when the queue is empty.
+        There is no Front/Discard pair since other consumers could claim the same element in between.
+        The slot stays claimed while Function runs, so the producer cannot reuse it until Function returns.
+    */
+    template <typename FunctionType>
+    bool Consume(FunctionType&& Function)
+    {
+        size_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+        while (true)
         {
-            bIsReading = false;
+            Slot& ReadSlot = GetSlot(ReadPosition);
+            const std::ptrdiff_t Difference = static_cast<std::ptrdiff_t>(ReadSlot.Sequence.load(std::memory_order_acquire) - (ReadPosition + 1));
+            if (Difference == 0)
+            {
+                if (m_ReadPosition.compare_exchange_weak(ReadPosition, ReadPosition + 1, std::memory_order_relaxed))
+                {
+                    Function(*ReadSlot.GetElement());
+                    std::allocator_traits<Allocator>::destroy(*this, ReadSlot.GetElement());
+                    ReadSlot.Sequence.store(ReadPosition + m_Capacity, std::memory_order_seq_cst);
+                    m_NotFullEvent.Notify();
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                m_Stats.OnPopEmpty();
+                return false;
+            }
+            else
+            {
+                ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+            }
+            m_Stats.OnReadRetry();
         }
+    }
 
-        Element = std::move(m_Data[m_ReadIndex + m_PaddingElementsNum]);
-        m_ReadIndex = IE_UNLIKELY(m_ReadIndex == m_Capacity) ? 0 : m_ReadIndex + 1;
-        m_Num.fetch_sub(1, std::memory_order_release);
-        m_bIsReading.store(false, std::memory_order_release);
-        return true;
+    template <typename... Args>
+    void PushWait(Args&&... _Args)
+    {
+        m_NotFullEvent.SpinThenWait([&] { return Push(std::forward<Args>(_Args)...); });
     }
 
-    std::optional<T> Pop()
+    void PopWait(T& Element)
     {
-        T Element;
-        if (Pop(Element))
-        {
-            return std::optional<T>(Element);
-        }
-        return std::nullopt;
+        m_NotEmptyEvent.SpinThenWait([&] { return Pop(Element); });
+    }
+
+    template <typename Rep, typename Period>
+    bool PopFor(T& Element, const std::chrono::duration<Rep, Period>& Timeout)
+    {
+        const std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(Timeout);
+        return m_NotEmptyEvent.SpinThenWaitUntil([&] { return Pop(Element); }, Deadline);
+    }
+
+    // co_await PopAsync(Executor) returns the next element, suspending until one is pushed and resuming on Executor.
+    IEPopAwaiter<IESPMCQueue> PopAsync(IECoroutineExecutor& Executor)
+    {
+        return IEPopAwaiter<IESPMCQueue>(*this, m_NotEmptyEvent, Executor);
+    }
+
+    // co_await PushAsync(Element, Executor) suspends while the queue is full and resumes on Executor once Element is pushed.
+    IEPushAwaiter<IESPMCQueue> PushAsync(T Element, IECoroutineExecutor& Executor)
+    {
+        return IEPushAwaiter<IESPMCQueue>(*this, m_NotFullEvent, Executor, std::move(Element));
     }
 
     bool IsEmpty() const
     {
-        return m_Num.load(std::memory_order_acquire) == 0;
+        const size_t ReadPosition = m_ReadPosition.load(std::memory_order_acquire);
+        const size_t Sequence = GetSlot(ReadPosition).Sequence.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(Sequence - (ReadPosition + 1)) < 0;
     }
 
     bool IsFull() const
     {
-        return m_Num.load(std::memory_order_acquire) >= m_Capacity;
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_acquire);
+        return GetSlot(WritePosition).Sequence.load(std::memory_order_acquire) != WritePosition;
     }
 
     size_t GetCapacity() const
@@ -88,13 +174,38 @@ public:
         return m_Capacity;
     }
 
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    Slot* AllocateSlots()
+    {
+        SlotAllocator SlotAlloc(*this);
+        Slot* Slots = std::allocator_traits<SlotAllocator>::allocate(SlotAlloc, m_Capacity + 2 * m_PaddingSlotsNum);
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            std::allocator_traits<SlotAllocator>::construct(SlotAlloc, Slots + m_PaddingSlotsNum + i, i);
+        }
+        return Slots;
+    }
+
+    Slot& GetSlot(size_t Position) const
+    {
+        return m_Slots[Position % m_Capacity + m_PaddingSlotsNum];
+    }
+
 private:
-    static constexpr size_t m_PaddingElementsNum = (IE_CACHE_LINE_SIZE - 1) / sizeof(T) + 1;
+    static constexpr size_t m_PaddingSlotsNum = (IE_CACHE_LINE_SIZE - 1) / sizeof(Slot) + 1;
     const size_t m_Capacity;
-    const typename std::allocator_traits<Allocator>::pointer m_Data;
+    Slot* const m_Slots;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WritePosition{ 0 };
+    size_t m_WriteIndex = 0;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_ReadPosition{ 0 };
 
-    alignas(IE_CACHE_LINE_SIZE) size_t m_WriteIndex = 0;
-    alignas(IE_CACHE_LINE_SIZE) size_t m_ReadIndex = 0;
-    alignas(IE_CACHE_LINE_SIZE) std::atomic<bool> m_bIsReading{false};
-    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_Num{ 0 };
-};
\ No newline at end of file
+    IEEventCount m_NotEmptyEvent;
+    IEEventCount m_NotFullEvent;
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+};
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IEConcurrencyCommon.h"
+#include "IEStats.h"
+
+/*
+    Single-producer single-consumer queue synchronized through separate write and read indices instead of a shared size counter.
+    Each side keeps a local copy of the other side's index and only reloads the remote cache line
+    when that copy suggests the queue is full (producer) or empty (consumer).
+*/
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = IENoStats>
+class IESPSCCachedQueue : private Allocator
+{
+public:
+    using ValueType = T;
+    IESPSCCachedQueue(size_t Size, const Allocator& QueueAllocator = Allocator()) :
+        Allocator(QueueAllocator),
+        m_Capacity(Size + 1),
+        m_Data(std::allocator_traits<Allocator>::allocate(*this, m_SlotsNum + 2 * m_PaddingElementsNum))
+    {}
+    IESPSCCachedQueue(const IESPSCCachedQueue&) = delete;
+    IESPSCCachedQueue& operator=(const IESPSCCachedQueue&) = delete;
+    ~IESPSCCachedQueue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            const size_t WriteIndex = m_WriteIndex.load(std::memory_order_relaxed);
+            for (size_t i = m_ReadIndex.load(std::memory_order_relaxed); i != WriteIndex; i = NextIndex(i))
+            {
+                std::allocator_traits<Allocator>::destroy(*this, m_Data + m_PaddingElementsNum + i);
+            }
+        }
+        std::allocator_traits<Allocator>::deallocate(*this, m_Data, m_SlotsNum + 2 * m_PaddingElementsNum);
+    }
+
+    template <typename... Args>
+    bool Push(Args&&... _Args)
+    {
+        const size_t WriteIndex = m_WriteIndex.load(std::memory_order_relaxed);
+        const size_t NextWriteIndex = NextIndex(WriteIndex);
+        if (IE_UNLIKELY(NextWriteIndex == m_CachedReadIndex))
+        {
+            m_CachedReadIndex = m_ReadIndex.load(std::memory_order_acquire);
+            if (NextWriteIndex == m_CachedReadIndex)
+            {
+                m_Stats.OnPushFail();
+                return false;
+            }
+        }
+
+        std::allocator_traits<Allocator>::construct(*this, m_Data + WriteIndex + m_PaddingElementsNum, std::forward<Args>(_Args)...);
+        m_WriteIndex.store(NextWriteIndex, std::memory_order_release);
+        if constexpr (Stats::bIsEnabled)
+        {
+            const size_t ReadIndex = m_ReadIndex.load(std::memory_order_relaxed);
+            m_Stats.OnSize(NextWriteIndex >= ReadIndex ? NextWriteIndex - ReadIndex : NextWriteIndex + m_SlotsNum - ReadIndex);
+        }
+        return true;
+    }
+
+    bool Pop(T& Element)
+    {
+        const size_t ReadIndex = m_ReadIndex.load(std::memory_order_relaxed);
+        if (IE_UNLIKELY(ReadIndex == m_CachedWriteIndex))
+        {
+            m_CachedWriteIndex = m_WriteIndex.load(std::memory_order_acquire);
+            if (ReadIndex == m_CachedWriteIndex)
+            {
+                m_Stats.OnPopEmpty();
+                return false;
+            }
+        }
+
+        Element = std::move(m_Data[ReadIndex + m_PaddingElementsNum]);
+        std::allocator_traits<Allocator>::destroy(*this, m_Data + ReadIndex + m_PaddingElementsNum);
+        m_ReadIndex.store(NextIndex(ReadIndex), std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> Pop()
+    {
+        T Element;
+        if (Pop(Element))
+        {
+            return std::optional<T>(std::move(Element));
+        }
+        return std::nullopt;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_ReadIndex.load(std::memory_order_acquire) == m_WriteIndex.load(std::memory_order_acquire);
+    }
+
+    bool IsFull() const
+    {
+        return NextIndex(m_WriteIndex.load(std::memory_order_acquire)) == m_ReadIndex.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    size_t NextIndex(size_t Index) const
+    {
+        return IE_UNLIKELY(Index == m_Capacity) ? 0 : Index + 1;
+    }
+
+private:
+    static constexpr size_t m_PaddingElementsNum = (IE_CACHE_LINE_SIZE - 1) / sizeof(T) + 1;
+    const size_t m_Capacity;
+    const size_t m_SlotsNum = m_Capacity + 1;
+    const typename std::allocator_traits<Allocator>::pointer m_Data;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WriteIndex{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) size_t m_CachedReadIndex = 0;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_ReadIndex{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) size_t m_CachedWriteIndex = 0;
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+};
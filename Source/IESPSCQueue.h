@@ -5,13 +5,17 @@
 #pragma once
 
 #include "IEConcurrencyCommon.h"
+#include "IEEventCount.h"
+#include "IEQueueAwaiter.h"
+#include "IEStats.h"
 
-template <typename T, typename Allocator = std::allocator<T>>
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = IENoStats>
 class IESPSCQueue : private Allocator
 {
 public:
     using ValueType = T;
-    IESPSCQueue(size_t Size) :
+    IESPSCQueue(size_t Size, const Allocator& QueueAllocator = Allocator()) :
+        Allocator(QueueAllocator),
         m_Capacity(Size + 1),
         m_Data(std::allocator_traits<Allocator>::allocate(*this, m_Capacity + 2 * m_PaddingElementsNum))
     {}
@@ -21,9 +25,11 @@ public:
     {
         if constexpr (!std::is_trivially_destructible_v<T>)
         {
-            for (std::size_t i = 0; i < m_Num.load(std::memory_order_relaxed); i++)
+            size_t Index = m_ReadIndex;
+            for (size_t i = 0; i < m_Num.load(std::memory_order_relaxed); i++)
             {
-                std::allocator_traits<Allocator>::destroy(*this, m_Data + m_PaddingElementsNum + i);
+                std::allocator_traits<Allocator>::destroy(*this, m_Data + m_PaddingElementsNum + Index);
+                Index = AdvanceIndex(Index, 1);
             }
         }
         std::allocator_traits<Allocator>::deallocate(*this, m_Data, m_Capacity + 2 * m_PaddingElementsNum);
@@ -34,36 +40,184 @@ public:
     {
         if (m_Num.load(std::memory_order_acquire) >= m_Capacity)
         {
+            m_Stats.OnPushFail();
             return false;
         }
 
         std::allocator_traits<Allocator>::construct(*this, m_Data + m_WriteIndex + m_PaddingElementsNum, std::forward<Args>(_Args)...);
         m_WriteIndex = IE_UNLIKELY(m_WriteIndex == m_Capacity) ? 0 : m_WriteIndex + 1;
-        m_Num.fetch_add(1, std::memory_order_release);
+        m_Stats.OnSize(m_Num.fetch_add(1, std::memory_order_seq_cst) + 1);
+        m_NotEmptyEvent.Notify();
         return true;
     }
 
     bool Pop(T& Element)
+    {
+        return Consume([&](T& FrontElement) { Element = std::move(FrontElement); });
+    }
+
+    // Move-constructs the element straight into the optional, so T needs no default constructor.
+    std::optional<T> Pop()
+    {
+        std::optional<T> Element;
+        Consume([&](T& FrontElement) { Element.emplace(std::move(FrontElement)); });
+        return Element;
+    }
+
+    // Consumer only. Returns the oldest element in place, or nullptr when the queue is empty.
+    // The element stays valid and owned by the queue until Discard.
+    T* Front()
     {
         if (m_Num.load(std::memory_order_acquire) == 0)
         {
-            return false;
+            m_Stats.OnPopEmpty();
+            return nullptr;
         }
+        return std::to_address(m_Data + m_ReadIndex + m_PaddingElementsNum);
+    }
 
-        Element = std::move(m_Data[m_ReadIndex + m_PaddingElementsNum]);
+    // Consumer only. Destroys the element returned by Front and releases its slot, the queue must not be empty.
+    void Discard()
+    {
+        std::allocator_traits<Allocator>::destroy(*this, m_Data + m_ReadIndex + m_PaddingElementsNum);
         m_ReadIndex = IE_UNLIKELY(m_ReadIndex == m_Capacity) ? 0 : m_ReadIndex + 1;
-        m_Num.fetch_sub(1, std::memory_order_release);
+        m_Num.fetch_sub(1, std::memory_order_seq_cst);
+        m_NotFullEvent.Notify();
+    }
+
+    // Consumer only. Calls Function(T&) on the oldest element in place and then discards it, returns false when the queue is empty.
+    template <typename FunctionType>
+    bool Consume(FunctionType&& Function)
+    {
+        T* Element = Front();
+        if (!Element)
+        {
+            return false;
+        }
+
+        Function(*Element);
+        Discard();
         return true;
     }
 
-    std::optional<T> Pop()
+    template <typename... Args>
+    void PushWait(Args&&... _Args)
+    {
+        m_NotFullEvent.SpinThenWait([&] { return Push(std::forward<Args>(_Args)...); });
+    }
+
+    void PopWait(T& Element)
+    {
+        m_NotEmptyEvent.SpinThenWait([&] { return Pop(Element); });
+    }
+
+    template <typename Rep, typename Period>
+    bool PopFor(T& Element, const std::chrono::duration<Rep, Period>& Timeout)
+    {
+        const std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(Timeout);
+        return m_NotEmptyEvent.SpinThenWaitUntil([&] { return Pop(Element); }, Deadline);
+    }
+
+    // co_await PopAsync(Executor) returns the next element, suspending until one is pushed and resuming on Executor.
+    IEPopAwaiter<IESPSCQueue> PopAsync(IECoroutineExecutor& Executor)
     {
-        T Element;
-        if (Pop(Element))
+        return IEPopAwaiter<IESPSCQueue>(*this, m_NotEmptyEvent, Executor);
+    }
+
+    // co_await PushAsync(Element, Executor) suspends while the queue is full and resumes on Executor once Element is pushed.
+    IEPushAwaiter<IESPSCQueue> PushAsync(T Element, IECoroutineExecutor& Executor)
+    {
+        return IEPushAwaiter<IESPSCQueue>(*this, m_NotFullEvent, Executor, std::move(Element));
+    }
+
+    // Pushes as many elements as currently fit and publishes them with a single atomic update.
+    // Returns the number of elements pushed.
+    size_t PushBulk(std::span<const T> Elements)
+    {
+        const size_t Num = std::min(Elements.size(), m_Capacity - m_Num.load(std::memory_order_acquire));
+        if (Num == 0)
         {
-            return std::optional<T>(Element);
+            m_Stats.OnPushFail();
+            return 0;
         }
-        return std::nullopt;
+
+        const size_t FirstPartNum = std::min(Num, m_SlotsNum - m_WriteIndex);
+        for (size_t i = 0; i < FirstPartNum; i++)
+        {
+            std::allocator_traits<Allocator>::construct(*this, m_Data + m_WriteIndex + m_PaddingElementsNum + i, Elements[i]);
+        }
+        for (size_t i = FirstPartNum; i < Num; i++)
+        {
+            std::allocator_traits<Allocator>::construct(*this, m_Data + m_PaddingElementsNum + i - FirstPartNum, Elements[i]);
+        }
+
+        m_WriteIndex = AdvanceIndex(m_WriteIndex, Num);
+        m_Stats.OnSize(m_Num.fetch_add(Num, std::memory_order_seq_cst) + Num);
+        m_NotEmptyEvent.Notify();
+        return Num;
+    }
+
+    // Pops up to Elements.size() elements and releases their slots with a single atomic update.
+    // Returns the number of elements popped.
+    size_t PopBulk(std::span<T> Elements)
+    {
+        const size_t Num = std::min(Elements.size(), m_Num.load(std::memory_order_acquire));
+        if (Num == 0)
+        {
+            m_Stats.OnPopEmpty();
+            return 0;
+        }
+
+        const size_t FirstPartNum = std::min(Num, m_SlotsNum - m_ReadIndex);
+        for (size_t i = 0; i < FirstPartNum; i++)
+        {
+            Elements[i] = std::move(m_Data[m_ReadIndex + m_PaddingElementsNum + i]);
+            std::allocator_traits<Allocator>::destroy(*this, m_Data + m_ReadIndex + m_PaddingElementsNum + i);
+        }
+        for (size_t i = FirstPartNum; i < Num; i++)
+        {
+            Elements[i] = std::move(m_Data[m_PaddingElementsNum + i - FirstPartNum]);
+            std::allocator_traits<Allocator>::destroy(*this, m_Data + m_PaddingElementsNum + i - FirstPartNum);
+        }
+
+        m_ReadIndex = AdvanceIndex(m_ReadIndex, Num);
+        m_Num.fetch_sub(Num, std::memory_order_seq_cst);
+        m_NotFullEvent.Notify();
+        return Num;
+    }
+
+    /*
+        Zero-copy producer access. Returns the largest contiguous writable region of at most MaxNum slots,
+        which may be shorter than the free space when it reaches the end of the ring.
+        Fill a prefix of it and publish with CommitWrite, then reserve again to continue past the wrap.
+    */
+    std::span<T> ReserveWrite(size_t MaxNum) requires std::is_trivially_copyable_v<T>
+    {
+        const size_t FreeNum = m_Capacity - m_Num.load(std::memory_order_acquire);
+        const size_t Num = std::min({ MaxNum, FreeNum, m_SlotsNum - m_WriteIndex });
+        return std::span<T>(std::to_address(m_Data + m_WriteIndex + m_PaddingElementsNum), Num);
+    }
+
+    void CommitWrite(size_t Num) requires std::is_trivially_copyable_v<T>
+    {
+        m_WriteIndex = AdvanceIndex(m_WriteIndex, Num);
+        m_Stats.OnSize(m_Num.fetch_add(Num, std::memory_order_seq_cst) + Num);
+        m_NotEmptyEvent.Notify();
+    }
+
+    // Zero-copy consumer access, the counterpart of ReserveWrite/CommitWrite.
+    std::span<const T> ReserveRead(size_t MaxNum) requires std::is_trivially_copyable_v<T>
+    {
+        const size_t AvailableNum = m_Num.load(std::memory_order_acquire);
+        const size_t Num = std::min({ MaxNum, AvailableNum, m_SlotsNum - m_ReadIndex });
+        return std::span<const T>(std::to_address(m_Data + m_ReadIndex + m_PaddingElementsNum), Num);
+    }
+
+    void CommitRead(size_t Num) requires std::is_trivially_copyable_v<T>
+    {
+        m_ReadIndex = AdvanceIndex(m_ReadIndex, Num);
+        m_Num.fetch_sub(Num, std::memory_order_seq_cst);
+        m_NotFullEvent.Notify();
     }
 
     bool IsEmpty() const
@@ -81,12 +235,29 @@ public:
         return m_Capacity;
     }
 
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    size_t AdvanceIndex(size_t Index, size_t Num) const
+    {
+        Index += Num;
+        return IE_UNLIKELY(Index >= m_SlotsNum) ? Index - m_SlotsNum : Index;
+    }
+
 private:
     static constexpr size_t m_PaddingElementsNum = (IE_CACHE_LINE_SIZE - 1) / sizeof(T) + 1;
     const size_t m_Capacity;
+    const size_t m_SlotsNum = m_Capacity + 1;
     const typename std::allocator_traits<Allocator>::pointer m_Data;
 
     alignas(IE_CACHE_LINE_SIZE) size_t m_WriteIndex = 0;
     alignas(IE_CACHE_LINE_SIZE) size_t m_ReadIndex = 0;
     alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_Num{ 0 };
+
+    IEEventCount m_NotEmptyEvent;
+    IEEventCount m_NotFullEvent;
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
 };
\ No newline at end of file
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "IEConcurrencyCommon.h"
+#include "IEStats.h"
+
+/*
+    Optimistic sequence lock for small trivially copyable objects.
+    The writer makes the sequence odd, stores the new value and makes it even again.
+    Readers copy the value without writing to shared memory and retry if the sequence was odd or changed during the copy,
+    so any number of readers never delay the writer. Concurrent writers are serialized by the CAS that makes the sequence odd.
+    The value is stored as relaxed atomic words so the racing copy is well defined.
+*/
+template<typename T, typename Stats = IENoStats>
+requires std::is_trivially_copyable_v<T>
+class alignas(IE_CACHE_LINE_SIZE) IESeqLock
+{
+private:
+    using Word = uint64_t;
+    static constexpr size_t m_WordsNum = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+public:
+    using ValueType = T;
+    explicit IESeqLock(const T& InitialValue = T())
+    {
+        StoreWords(InitialValue);
+    }
+    IESeqLock(const IESeqLock&) = delete;
+    IESeqLock& operator=(const IESeqLock&) = delete;
+
+public:
+    void Write(const T& NewValue)
+    {
+        size_t Sequence = m_Sequence.load(std::memory_order_relaxed);
+        while ((Sequence & 1) != 0 || !m_Sequence.compare_exchange_weak(Sequence, Sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            m_Stats.OnWriteRetry();
+            IE_CPU_RELAX();
+            Sequence = m_Sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        StoreWords(NewValue);
+        m_Sequence.store(Sequence + 2, std::memory_order_release);
+    }
+
+    T Read() const
+    {
+        T Value;
+        while (!TryRead(Value))
+        {
+            m_Stats.OnReadRetry();
+            IE_CPU_RELAX();
+        }
+        return Value;
+    }
+
+    // Single optimistic attempt, returns false if a write overlapped the copy.
+    bool TryRead(T& Value) const
+    {
+        const size_t Sequence = m_Sequence.load(std::memory_order_acquire);
+        if ((Sequence & 1) != 0)
+        {
+            return false;
+        }
+
+        Word Words[m_WordsNum];
+        for (size_t i = 0; i < m_WordsNum; i++)
+        {
+            Words[i] = m_Words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_Sequence.load(std::memory_order_relaxed) != Sequence)
+        {
+            return false;
+        }
+
+        std::memcpy(&Value, Words, sizeof(T));
+        return true;
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    void StoreWords(const T& Value)
+    {
+        Word Words[m_WordsNum] = {};
+        std::memcpy(Words, &Value, sizeof(T));
+        for (size_t i = 0; i < m_WordsNum; i++)
+        {
+            m_Words[i].store(Words[i], std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<size_t> m_Sequence{ 0 };
+    std::atomic<Word> m_Words[m_WordsNum];
+    IE_NO_UNIQUE_ADDRESS mutable Stats m_Stats;
+};
@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Single-producer single-consumer queue living in a shared memory region so the producer and the consumer can be separate processes.
+    The region starts with a header holding the layout version, the capacity, the offset of the ring and the write and read indices,
+    so nothing in it depends on the address it is mapped at. Synchronization follows IESPSCCachedQueue,
+    with each side caching the other side's index in process-local memory.
+    The peer process may be buggy or hostile, so each side keeps its own index in process-local memory and only publishes it to the header,
+    the layout is read from the header once when attaching, and an index read from the peer is range checked before use.
+    Elements are copied byte for byte between processes, which is why T must be trivially copyable.
+*/
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class IESharedMemorySPSCQueue
+{
+private:
+    struct Header
+    {
+        std::atomic<uint32_t> Magic;
+        uint32_t LayoutVersion;
+        uint64_t HeaderSize;
+        uint64_t ElementSize;
+        uint64_t ElementAlignment;
+        uint64_t Capacity;
+        uint64_t DataOffset;
+
+        alignas(IE_CACHE_LINE_SIZE) std::atomic<uint64_t> WriteIndex;
+        alignas(IE_CACHE_LINE_SIZE) std::atomic<uint64_t> ReadIndex;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "Shared memory atomics must be lock-free.");
+
+public:
+    using ValueType = T;
+    static constexpr uint32_t LayoutVersion = 1;
+
+public:
+    // Creates the named region, fails if it already exists. The name is unlinked when the creating queue is destroyed.
+    static std::optional<IESharedMemorySPSCQueue> Create(const std::string& Name, size_t Size)
+    {
+        const int FileDescriptor = shm_open(Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (FileDescriptor < 0)
+        {
+            return std::nullopt;
+        }
+        std::optional<IESharedMemorySPSCQueue> Queue = CreateInFile(FileDescriptor, Size);
+        if (Queue)
+        {
+            Queue->m_OwnedName = Name;
+        }
+        else
+        {
+            shm_unlink(Name.c_str());
+        }
+        return Queue;
+    }
+
+    static std::optional<IESharedMemorySPSCQueue> Attach(const std::string& Name)
+    {
+        const int FileDescriptor = shm_open(Name.c_str(), O_RDWR, 0600);
+        if (FileDescriptor < 0)
+        {
+            return std::nullopt;
+        }
+        return AttachToFile(FileDescriptor);
+    }
+
+#if defined(__linux__)
+    // Creates an unnamed region, shared with child processes across fork or with other processes by passing GetFileDescriptor() over a socket.
+    static std::optional<IESharedMemorySPSCQueue> CreateAnonymous(size_t Size)
+    {
+        const int FileDescriptor = memfd_create("IESharedMemorySPSCQueue", MFD_CLOEXEC);
+        if (FileDescriptor < 0)
+        {
+            return std::nullopt;
+        }
+        return CreateInFile(FileDescriptor, Size);
+    }
+#endif
+
+    // Attaches to a region received as a file descriptor, the queue takes ownership of FileDescriptor.
+    static std::optional<IESharedMemorySPSCQueue> Attach(int FileDescriptor)
+    {
+        return AttachToFile(FileDescriptor);
+    }
+
+public:
+    IESharedMemorySPSCQueue(IESharedMemorySPSCQueue&& Other) noexcept :
+        m_FileDescriptor(std::exchange(Other.m_FileDescriptor, -1)),
+        m_MappingSize(std::exchange(Other.m_MappingSize, 0)),
+        m_Header(std::exchange(Other.m_Header, nullptr)),
+        m_Data(std::exchange(Other.m_Data, nullptr)),
+        m_Capacity(Other.m_Capacity),
+        m_OwnedName(std::move(Other.m_OwnedName)),
+        m_WriteIndex(Other.m_WriteIndex),
+        m_CachedReadIndex(Other.m_CachedReadIndex),
+        m_ReadIndex(Other.m_ReadIndex),
+        m_CachedWriteIndex(Other.m_CachedWriteIndex)
+    {
+        Other.m_OwnedName.clear();
+    }
+    IESharedMemorySPSCQueue(const IESharedMemorySPSCQueue&) = delete;
+    IESharedMemorySPSCQueue& operator=(const IESharedMemorySPSCQueue&) = delete;
+    ~IESharedMemorySPSCQueue()
+    {
+        if (m_Header)
+        {
+            munmap(m_Header, m_MappingSize);
+        }
+        if (m_FileDescriptor >= 0)
+        {
+            close(m_FileDescriptor);
+        }
+        if (!m_OwnedName.empty())
+        {
+            shm_unlink(m_OwnedName.c_str());
+        }
+    }
+
+public:
+    // Producer only. Also fails if the consumer published an index outside the ring.
+    template <typename... Args>
+    bool Push(Args&&... _Args)
+    {
+        const size_t NextWriteIndex = NextIndex(m_WriteIndex);
+        if (IE_UNLIKELY(NextWriteIndex == m_CachedReadIndex))
+        {
+            const size_t ReadIndex = m_Header->ReadIndex.load(std::memory_order_acquire);
+            if (IE_UNLIKELY(ReadIndex > m_Capacity))
+            {
+                return false;
+            }
+            m_CachedReadIndex = ReadIndex;
+            if (NextWriteIndex == m_CachedReadIndex)
+            {
+                return false;
+            }
+        }
+
+        std::construct_at(m_Data + m_WriteIndex, std::forward<Args>(_Args)...);
+        m_WriteIndex = NextWriteIndex;
+        m_Header->WriteIndex.store(NextWriteIndex, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& Element)
+    {
+        return Consume([&](const T& FrontElement) { Element = FrontElement; });
+    }
+
+    std::optional<T> Pop()
+    {
+        std::optional<T> Element;
+        Consume([&](const T& FrontElement) { Element.emplace(FrontElement); });
+        return Element;
+    }
+
+    // Consumer only. Calls Function(const T&) on the oldest element in shared memory and then releases its slot,
+    // returns false when the queue is empty or the producer published an index outside the ring.
+    template <typename FunctionType>
+    bool Consume(FunctionType&& Function)
+    {
+        if (IE_UNLIKELY(m_ReadIndex == m_CachedWriteIndex))
+        {
+            const size_t WriteIndex = m_Header->WriteIndex.load(std::memory_order_acquire);
+            if (IE_UNLIKELY(WriteIndex > m_Capacity))
+            {
+                return false;
+            }
+            m_CachedWriteIndex = WriteIndex;
+            if (m_ReadIndex == m_CachedWriteIndex)
+            {
+                return false;
+            }
+        }
+
+        Function(std::as_const(m_Data[m_ReadIndex]));
+        m_ReadIndex = NextIndex(m_ReadIndex);
+        m_Header->ReadIndex.store(m_ReadIndex, std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_Header->ReadIndex.load(std::memory_order_acquire) == m_Header->WriteIndex.load(std::memory_order_acquire);
+    }
+
+    bool IsFull() const
+    {
+        return NextIndex(m_Header->WriteIndex.load(std::memory_order_acquire)) == m_Header->ReadIndex.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+    int GetFileDescriptor() const
+    {
+        return m_FileDescriptor;
+    }
+
+private:
+    // Capacity and the indices are the values validated by the caller, never re-read from the header.
+    IESharedMemorySPSCQueue(int FileDescriptor, size_t MappingSize, Header* MappedHeader, size_t Capacity, size_t WriteIndex, size_t ReadIndex) :
+        m_FileDescriptor(FileDescriptor),
+        m_MappingSize(MappingSize),
+        m_Header(MappedHeader),
+        m_Data(reinterpret_cast<T*>(reinterpret_cast<std::byte*>(MappedHeader) + GetDataOffset())),
+        m_Capacity(Capacity),
+        m_WriteIndex(WriteIndex),
+        m_CachedReadIndex(ReadIndex),
+        m_ReadIndex(ReadIndex),
+        m_CachedWriteIndex(WriteIndex)
+    {}
+
+    static constexpr size_t GetDataOffset()
+    {
+        return (sizeof(Header) + IE_CACHE_LINE_SIZE - 1) / IE_CACHE_LINE_SIZE * IE_CACHE_LINE_SIZE;
+    }
+
+    static std::optional<IESharedMemorySPSCQueue> CreateInFile(int FileDescriptor, size_t Size)
+    {
+        const size_t Capacity = Size + 1;
+        const size_t MappingSize = GetDataOffset() + (Capacity + 1) * sizeof(T);
+        if (ftruncate(FileDescriptor, static_cast<off_t>(MappingSize)) != 0)
+        {
+            close(FileDescriptor);
+            return std::nullopt;
+        }
+        void* Mapping = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, 0);
+        if (Mapping == MAP_FAILED)
+        {
+            close(FileDescriptor);
+            return std::nullopt;
+        }
+
+        Header* MappedHeader = new (Mapping) Header();
+        MappedHeader->LayoutVersion = LayoutVersion;
+        MappedHeader->HeaderSize = sizeof(Header);
+        MappedHeader->ElementSize = sizeof(T);
+        MappedHeader->ElementAlignment = alignof(T);
+        MappedHeader->Capacity = Capacity;
+        MappedHeader->DataOffset = GetDataOffset();
+        MappedHeader->Magic.store(m_Magic, std::memory_order_release);
+        return IESharedMemorySPSCQueue(FileDescriptor, MappingSize, MappedHeader, Capacity, 0, 0);
+    }
+
+    static std::optional<IESharedMemorySPSCQueue> AttachToFile(int FileDescriptor)
+    {
+        struct stat FileStatus;
+        if (fstat(FileDescriptor, &FileStatus) != 0 || static_cast<size_t>(FileStatus.st_size) < GetDataOffset())
+        {
+            close(FileDescriptor);
+            return std::nullopt;
+        }
+        const size_t MappingSize = static_cast<size_t>(FileStatus.st_size);
+        void* Mapping = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, 0);
+        if (Mapping == MAP_FAILED)
+        {
+            close(FileDescriptor);
+            return std::nullopt;
+        }
+
+        // Reject regions that are still being created, were created by an incompatible build or element type, or hold indices outside the ring.
+        // Every value is read once, so the peer can't change it between this check and its use.
+        Header* MappedHeader = static_cast<Header*>(Mapping);
+        const size_t Capacity = MappedHeader->Capacity;
+        const size_t WriteIndex = MappedHeader->WriteIndex.load(std::memory_order_acquire);
+        const size_t ReadIndex = MappedHeader->ReadIndex.load(std::memory_order_acquire);
+        const bool bIsCompatible = MappedHeader->Magic.load(std::memory_order_acquire) == m_Magic
+            && MappedHeader->LayoutVersion == LayoutVersion
+            && MappedHeader->HeaderSize == sizeof(Header)
+            && MappedHeader->ElementSize == sizeof(T)
+            && MappedHeader->ElementAlignment == alignof(T)
+            && MappedHeader->DataOffset == GetDataOffset()
+            && Capacity > 0
+            && Capacity < MappingSize / sizeof(T)
+            && GetDataOffset() + (Capacity + 1) * sizeof(T) <= MappingSize
+            && WriteIndex <= Capacity
+            && ReadIndex <= Capacity;
+        if (!bIsCompatible)
+        {
+            munmap(Mapping, MappingSize);
+            close(FileDescriptor);
+            return std::nullopt;
+        }
+        return IESharedMemorySPSCQueue(FileDescriptor, MappingSize, MappedHeader, Capacity, WriteIndex, ReadIndex);
+    }
+
+    size_t NextIndex(size_t Index) const
+    {
+        return IE_UNLIKELY(Index == m_Capacity) ? 0 : Index + 1;
+    }
+
+private:
+    static constexpr uint32_t m_Magic = 0x49455351;
+    int m_FileDescriptor = -1;
+    size_t m_MappingSize = 0;
+    Header* m_Header = nullptr;
+    T* m_Data = nullptr;
+    size_t m_Capacity = 0;
+    std::string m_OwnedName;
+
+    alignas(IE_CACHE_LINE_SIZE) size_t m_WriteIndex = 0;
+    size_t m_CachedReadIndex = 0;
+    alignas(IE_CACHE_LINE_SIZE) size_t m_ReadIndex = 0;
+    size_t m_CachedWriteIndex = 0;
+};
+
+#endif
@@ -5,38 +5,60 @@
 #pragma once
 
 #include "IEConcurrencyCommon.h"
+#include "IEStats.h"
 
-template<typename T>
-class IESpinOnWriteObject
+enum class IESpinOnWriteStorage
+{
+    // Every write allocates a new version and frees the previous one.
+    Heap,
+    // Two versions are allocated at construction and reused in place, so steady-state writes never allocate nor free.
+    Preallocated
+};
+
+template<typename T, IESpinOnWriteStorage Storage = IESpinOnWriteStorage::Heap, typename Allocator = std::allocator<T>, typename Stats = IENoStats>
+class IESpinOnWriteObject : private Allocator
 {
 public:
-    explicit IESpinOnWriteObject(const T& ObjectValue = T()) : 
-        m_ObjectStorage(std::make_unique<T>(ObjectValue)),
-        m_Object(m_ObjectStorage.get())
+    explicit IESpinOnWriteObject(const T& ObjectValue = T()) :
+        m_ObjectStorage(CreateObject(ObjectValue)),
+        m_Object(m_ObjectStorage)
     {
+        if constexpr (Storage == IESpinOnWriteStorage::Preallocated)
+        {
+            m_SpareObjectStorage = CreateObject(ObjectValue);
+        }
     }
 
     IESpinOnWriteObject(IESpinOnWriteObject&& Other) noexcept :
-        m_ObjectStorage(std::move(Other.m_ObjectStorage)),
-        m_Object(m_ObjectStorage.get())
+        Allocator(static_cast<Allocator&>(Other)),
+        m_ObjectStorage(std::exchange(Other.m_ObjectStorage, nullptr)),
+        m_SpareObjectStorage(std::exchange(Other.m_SpareObjectStorage, nullptr)),
+        m_Object(m_ObjectStorage)
     {
         Other.m_Object.store(nullptr);
     }
 
     IESpinOnWriteObject(const IESpinOnWriteObject&) = delete;
     IESpinOnWriteObject& operator=(const IESpinOnWriteObject&) = delete;
+    ~IESpinOnWriteObject()
+    {
+        DestroyObject(m_ObjectStorage);
+        DestroyObject(m_SpareObjectStorage);
+    }
 
 private:
     class ScopedLock
     {
     private:
-        explicit ScopedLock(IESpinOnWriteObject<T>& SpinOnWriteObject) :
-            m_SpinOnWriteObject(SpinOnWriteObject)
+        explicit ScopedLock(IESpinOnWriteObject& SpinOnWriteObject, const T* LockedObject, typename Stats::ReadLockToken ReadLockToken) :
+            m_SpinOnWriteObject(SpinOnWriteObject),
+            m_LockedObject(LockedObject),
+            m_ReadLockToken(ReadLockToken)
         {
         }
         ~ScopedLock()
         {
-            m_SpinOnWriteObject.Unlock(*m_SpinOnWriteObject.m_ObjectStorage);
+            m_SpinOnWriteObject.Unlock(*m_LockedObject, m_ReadLockToken);
         }
 
         ScopedLock(ScopedLock&&) = delete;
@@ -44,7 +66,9 @@ private:
         ScopedLock& operator=(const ScopedLock&) = delete;
 
     private:
-        IESpinOnWriteObject<T>& m_SpinOnWriteObject;
+        IESpinOnWriteObject& m_SpinOnWriteObject;
+        const T* const m_LockedObject;
+        IE_NO_UNIQUE_ADDRESS const typename Stats::ReadLockToken m_ReadLockToken;
         friend class IESpinOnWriteObject;
     };
 
@@ -58,28 +82,104 @@ public:
 public:
     const LockedValue LockForRead()
     {
-        return LockedValue{ IESpinOnWriteObject::ScopedLock(*this), *m_Object.exchange(nullptr) };
+        const typename Stats::ReadLockToken ReadLockToken = m_Stats.BeginReadLock();
+        const T* LockedObject = m_Object.exchange(nullptr);
+        return LockedValue{ IESpinOnWriteObject::ScopedLock(*this, LockedObject, ReadLockToken), *LockedObject };
     }
 
     void Write(const T& NewObject)
     {
-        std::unique_ptr<const T> NewObjectStorage = std::make_unique<T>(NewObject);
-        const T* Expected = m_ObjectStorage.get();
-        const T* Desired = NewObjectStorage.get();
-        while (!m_Object.compare_exchange_weak(Expected, Desired))
+        if constexpr (Storage == IESpinOnWriteStorage::Heap)
+        {
+            m_SpareObjectStorage = CreateObject(NewObject);
+        }
+        else
+        {
+            *m_SpareObjectStorage = NewObject;
+        }
+        Publish();
+    }
+
+    void Write(T&& NewObject)
+    {
+        if constexpr (Storage == IESpinOnWriteStorage::Heap)
+        {
+            m_SpareObjectStorage = CreateObject(std::move(NewObject));
+        }
+        else
+        {
+            *m_SpareObjectStorage = std::move(NewObject);
+        }
+        Publish();
+    }
+
+    // Copies the current version, lets ModifyFunction edit the copy in place and publishes it.
+    template<typename ModifyFunctionType>
+    void Modify(ModifyFunctionType&& ModifyFunction)
+    {
+        if constexpr (Storage == IESpinOnWriteStorage::Heap)
         {
-            Expected = m_ObjectStorage.get();
+            m_SpareObjectStorage = CreateObject(*m_ObjectStorage);
         }
-        m_ObjectStorage = std::move(NewObjectStorage);
+        else
+        {
+            *m_SpareObjectStorage = *m_ObjectStorage;
+        }
+        ModifyFunction(*m_SpareObjectStorage);
+        Publish();
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
     }
 
 private:
-    void Unlock(const T& Object)
+    // Swaps the spare version in once no reader holds the current one.
+    // The previous version can't be locked afterwards, so it becomes the new spare or is freed.
+    void Publish()
+    {
+        const T* Expected = m_ObjectStorage;
+        const T* Desired = m_SpareObjectStorage;
+        while (!m_Object.compare_exchange_weak(Expected, Desired))
+        {
+            m_Stats.OnWriteRetry();
+            Expected = m_ObjectStorage;
+        }
+        std::swap(m_ObjectStorage, m_SpareObjectStorage);
+        if constexpr (Storage == IESpinOnWriteStorage::Heap)
+        {
+            DestroyObject(m_SpareObjectStorage);
+            m_SpareObjectStorage = nullptr;
+        }
+    }
+
+    template <typename... Args>
+    T* CreateObject(Args&&... _Args)
+    {
+        T* Object = std::allocator_traits<Allocator>::allocate(*this, 1);
+        std::allocator_traits<Allocator>::construct(*this, Object, std::forward<Args>(_Args)...);
+        return Object;
+    }
+
+    void DestroyObject(T* Object)
+    {
+        if (Object)
+        {
+            std::allocator_traits<Allocator>::destroy(*this, Object);
+            std::allocator_traits<Allocator>::deallocate(*this, Object, 1);
+        }
+    }
+
+    void Unlock(const T& Object, typename Stats::ReadLockToken ReadLockToken)
     {
         m_Object.store(&Object);
+        m_Stats.EndReadLock(ReadLockToken);
     }
 
 private:
-    std::unique_ptr<const T> m_ObjectStorage;
+    T* m_ObjectStorage = nullptr;
+    T* m_SpareObjectStorage = nullptr;
     std::atomic<const T*> m_Object;
-};
\ No newline at end of file
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+};
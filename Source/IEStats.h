@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "IEConcurrencyCommon.h"
+
+// Point-in-time copy of the counters of an IEStats policy, as returned by the primitives' GetStats.
+struct IEStatsSnapshot
+{
+    uint64_t PushFailsNum = 0;
+    uint64_t PopEmptyNum = 0;
+    uint64_t PeakSize = 0;
+    uint64_t WriteRetriesNum = 0;
+    uint64_t ReadRetriesNum = 0;
+    uint64_t ReadLocksNum = 0;
+    uint64_t ReadLockHoldNs = 0;
+    uint64_t MaxReadLockHoldNs = 0;
+};
+
+/*
+    Default stats policy of every instrumented primitive.
+    Every hook is empty and the primitives only compute what they pass to it under if constexpr (Stats::bIsEnabled),
+    so an uninstrumented primitive emits no code and takes no space for it.
+*/
+struct IENoStats
+{
+    static constexpr bool bIsEnabled = false;
+    struct ReadLockToken {};
+
+    void OnPushFail() {}
+    void OnPopEmpty() {}
+    void OnSize(size_t) {}
+    void OnWriteRetry() {}
+    void OnReadRetry() {}
+    ReadLockToken BeginReadLock() { return ReadLockToken{}; }
+    void EndReadLock(ReadLockToken) {}
+
+    IEStatsSnapshot GetSnapshot() const
+    {
+        return IEStatsSnapshot{};
+    }
+};
+
+/*
+    Stats policy counting failed operations, retries, the peak number of elements and reader lock hold times.
+    Counters are relaxed atomics grouped by the side updating them, writers and readers each on their own cache line,
+    so enabling the stats never puts a counter on a cache line the other side uses.
+    Reader counters are striped by thread as in IEReadIndicator, so concurrent readers and competing consumers don't share a line either,
+    and GetSnapshot sums the stripes.
+    Queues without a shared size counter sample PeakSize with a relaxed load of the consumer's position on push.
+*/
+class IEStats
+{
+public:
+    static constexpr bool bIsEnabled = true;
+    using ReadLockToken = std::chrono::steady_clock::time_point;
+    static constexpr size_t StripesNum = 16;
+
+public:
+    IEStats() = default;
+    IEStats(const IEStats&) = delete;
+    IEStats& operator=(const IEStats&) = delete;
+
+public:
+    void OnPushFail()
+    {
+        m_WriterCounters.PushFailsNum.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnPopEmpty()
+    {
+        GetReaderCounters().PopEmptyNum.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnSize(size_t Size)
+    {
+        UpdateMax(m_WriterCounters.PeakSize, Size);
+    }
+
+    void OnWriteRetry()
+    {
+        m_WriterCounters.WriteRetriesNum.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnReadRetry()
+    {
+        GetReaderCounters().ReadRetriesNum.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ReadLockToken BeginReadLock()
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    void EndReadLock(ReadLockToken Token)
+    {
+        const uint64_t HoldNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Token).count();
+        ReaderCounters& Counters = GetReaderCounters();
+        Counters.ReadLocksNum.fetch_add(1, std::memory_order_relaxed);
+        Counters.ReadLockHoldNs.fetch_add(HoldNs, std::memory_order_relaxed);
+        UpdateMax(Counters.MaxReadLockHoldNs, HoldNs);
+    }
+
+    IEStatsSnapshot GetSnapshot() const
+    {
+        IEStatsSnapshot Snapshot;
+        Snapshot.PushFailsNum = m_WriterCounters.PushFailsNum.load(std::memory_order_relaxed);
+        Snapshot.PeakSize = m_WriterCounters.PeakSize.load(std::memory_order_relaxed);
+        Snapshot.WriteRetriesNum = m_WriterCounters.WriteRetriesNum.load(std::memory_order_relaxed);
+        for (const ReaderCounters& Counters : m_ReaderCounters)
+        {
+            Snapshot.PopEmptyNum += Counters.PopEmptyNum.load(std::memory_order_relaxed);
+            Snapshot.ReadRetriesNum += Counters.ReadRetriesNum.load(std::memory_order_relaxed);
+            Snapshot.ReadLocksNum += Counters.ReadLocksNum.load(std::memory_order_relaxed);
+            Snapshot.ReadLockHoldNs += Counters.ReadLockHoldNs.load(std::memory_order_relaxed);
+            Snapshot.MaxReadLockHoldNs = std::max(Snapshot.MaxReadLockHoldNs, Counters.MaxReadLockHoldNs.load(std::memory_order_relaxed));
+        }
+        return Snapshot;
+    }
+
+private:
+    // Only writes when Value is a new maximum, which quickly becomes rare.
+    static void UpdateMax(std::atomic<uint64_t>& Max, uint64_t Value)
+    {
+        uint64_t CurrentMax = Max.load(std::memory_order_relaxed);
+        while (Value > CurrentMax && !Max.compare_exchange_weak(CurrentMax, Value, std::memory_order_relaxed)) {}
+    }
+
+private:
+    struct alignas(IE_CACHE_LINE_SIZE) WriterCounters
+    {
+        std::atomic<uint64_t> PushFailsNum{ 0 };
+        std::atomic<uint64_t> PeakSize{ 0 };
+        std::atomic<uint64_t> WriteRetriesNum{ 0 };
+    };
+
+    struct alignas(IE_CACHE_LINE_SIZE) ReaderCounters
+    {
+        std::atomic<uint64_t> PopEmptyNum{ 0 };
+        std::atomic<uint64_t> ReadRetriesNum{ 0 };
+        std::atomic<uint64_t> ReadLocksNum{ 0 };
+        std::atomic<uint64_t> ReadLockHoldNs{ 0 };
+        std::atomic<uint64_t> MaxReadLockHoldNs{ 0 };
+    };
+
+    ReaderCounters& GetReaderCounters()
+    {
+        return m_ReaderCounters[IEGetThreadIndex() % StripesNum];
+    }
+
+    WriterCounters m_WriterCounters;
+    ReaderCounters m_ReaderCounters[StripesNum];
+};
@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "IEConcurrencyCommon.h"
+#include "IEEventCount.h"
+#include "IEMPMCQueue.h"
+#include "IEWorkStealingDeque.h"
+
+/*
+    Fork-join thread pool where every worker owns a work-stealing deque.
+    Tasks spawned from a worker go to the bottom of its own deque and idle workers steal them from the top,
+    tasks submitted from outside the pool go through a shared bounded injection queue.
+    Idle workers spin briefly and then park on an event count, so a busy pool never makes a system call to hand out work.
+*/
+class IEThreadPool
+{
+private:
+    struct Task
+    {
+        void (*Execute)(Task&);
+    };
+
+    // Lives on the stack of the thread joining it.
+    template <typename FunctionType>
+    struct JoinTask : Task
+    {
+        explicit JoinTask(FunctionType& InFunction) : Task{ &JoinTask::Run }, Function(InFunction) {}
+        static void Run(Task& Self)
+        {
+            JoinTask& This = static_cast<JoinTask&>(Self);
+            This.Function();
+            This.bIsDone.store(true, std::memory_order_seq_cst);
+        }
+
+        FunctionType& Function;
+        std::atomic<bool> bIsDone{ false };
+    };
+
+    // Fire and forget, deletes itself once executed.
+    template <typename FunctionType>
+    struct DetachedTask : Task
+    {
+        explicit DetachedTask(FunctionType&& InFunction) : Task{ &DetachedTask::Run }, Function(std::move(InFunction)) {}
+        static void Run(Task& Self)
+        {
+            DetachedTask* This = static_cast<DetachedTask*>(&Self);
+            This->Function();
+            delete This;
+        }
+
+        FunctionType Function;
+    };
+
+    struct alignas(IE_CACHE_LINE_SIZE) Worker
+    {
+        explicit Worker(size_t DequeSize) : Deque(DequeSize) {}
+
+        IEWorkStealingDeque<Task*> Deque;
+        uint32_t RandomState = 0;
+        std::thread Thread;
+    };
+
+    struct WorkerContext
+    {
+        IEThreadPool* ThreadPool = nullptr;
+        size_t WorkerIndex = 0;
+    };
+
+public:
+    explicit IEThreadPool(size_t WorkersNum = std::thread::hardware_concurrency(), size_t DequeSize = 1 << 12, size_t InjectionQueueSize = 1 << 12) :
+        m_InjectionQueue(InjectionQueueSize)
+    {
+        WorkersNum = std::max<size_t>(WorkersNum, 1);
+        m_Workers.reserve(WorkersNum);
+        for (size_t i = 0; i < WorkersNum; i++)
+        {
+            m_Workers.emplace_back(std::make_unique<Worker>(DequeSize));
+            m_Workers.back()->RandomState = static_cast<uint32_t>(i * 2654435761u) | 1;
+        }
+        for (size_t i = 0; i < WorkersNum; i++)
+        {
+            m_Workers[i]->Thread = std::thread(&IEThreadPool::RunWorker, this, i);
+        }
+    }
+    IEThreadPool(const IEThreadPool&) = delete;
+    IEThreadPool& operator=(const IEThreadPool&) = delete;
+    // Tasks must not be submitted from outside the pool once destruction has started.
+    ~IEThreadPool()
+    {
+        // Let the workers pick up what was submitted from outside, so no task is lost
+        // and those still able to call back into the pool while it has workers.
+        while (!m_InjectionQueue.IsEmpty())
+        {
+            std::this_thread::yield();
+        }
+
+        m_bIsStopping.store(true, std::memory_order_seq_cst);
+        m_WorkAvailableEvent.Notify();
+        for (std::unique_ptr<Worker>& Worker : m_Workers)
+        {
+            Worker->Thread.join();
+        }
+    }
+
+public:
+    // Runs Function asynchronously on the pool.
+    template <typename FunctionType>
+    void Submit(FunctionType&& Function)
+    {
+        Task* NewTask = new DetachedTask<std::decay_t<FunctionType>>(std::forward<FunctionType>(Function));
+        if (Worker* CurrentWorker = GetCurrentWorker())
+        {
+            if (!CurrentWorker->Deque.Push(NewTask))
+            {
+                NewTask->Execute(*NewTask);
+                return;
+            }
+        }
+        else
+        {
+            while (!m_InjectionQueue.Push(NewTask))
+            {
+                std::this_thread::yield();
+            }
+        }
+        NotifyWorkAvailable();
+    }
+
+    // Runs FunctionA and FunctionB potentially in parallel and returns once both have completed.
+    // While waiting, the calling worker keeps executing other tasks instead of blocking.
+    template <typename FunctionTypeA, typename FunctionTypeB>
+    void Invoke(FunctionTypeA&& FunctionA, FunctionTypeB&& FunctionB)
+    {
+        Worker* CurrentWorker = GetCurrentWorker();
+        if (!CurrentWorker)
+        {
+            RunFromOutside([&] { Invoke(FunctionA, FunctionB); });
+            return;
+        }
+
+        JoinTask<FunctionTypeB> TaskB(FunctionB);
+        if (!CurrentWorker->Deque.Push(&TaskB))
+        {
+            FunctionA();
+            FunctionB();
+            return;
+        }
+        NotifyWorkAvailable();
+
+        FunctionA();
+
+        // Most of the time nobody stole TaskB and it is still at the bottom of the deque.
+        // Any task run here may be an outside thread's root task, so its completion is notified as in RunWorker.
+        Task* NextTask = nullptr;
+        if (CurrentWorker->Deque.Pop(NextTask))
+        {
+            NextTask->Execute(*NextTask);
+            m_JoinEvent.Notify();
+        }
+        while (!TaskB.bIsDone.load(std::memory_order_acquire))
+        {
+            if (FindTask(*CurrentWorker, NextTask))
+            {
+                NextTask->Execute(*NextTask);
+                m_JoinEvent.Notify();
+            }
+            else
+            {
+                IE_CPU_RELAX();
+            }
+        }
+    }
+
+    // Calls Function(i) for every i in [Begin, End), recursively splitting the range down to chunks of at most Grain indices.
+    template <typename FunctionType>
+    void ParallelFor(size_t Begin, size_t End, size_t Grain, FunctionType&& Function)
+    {
+        Grain = std::max<size_t>(Grain, 1);
+        if (End - Begin <= Grain)
+        {
+            for (size_t i = Begin; i < End; i++)
+            {
+                Function(i);
+            }
+            return;
+        }
+
+        const size_t Middle = Begin + (End - Begin) / 2;
+        Invoke([&] { ParallelFor(Begin, Middle, Grain, Function); }, [&] { ParallelFor(Middle, End, Grain, Function); });
+    }
+
+    size_t GetWorkersNum() const
+    {
+        return m_Workers.size();
+    }
+
+private:
+    static WorkerContext& GetWorkerContext()
+    {
+        thread_local WorkerContext Context;
+        return Context;
+    }
+
+    Worker* GetCurrentWorker()
+    {
+        const WorkerContext& Context = GetWorkerContext();
+        return Context.ThreadPool == this ? m_Workers[Context.WorkerIndex].get() : nullptr;
+    }
+
+    // Blocks an outside thread until Function has run on one of the workers.
+    template <typename FunctionType>
+    void RunFromOutside(FunctionType&& Function)
+    {
+        JoinTask<FunctionType> RootTask(Function);
+        while (!m_InjectionQueue.Push(&RootTask))
+        {
+            std::this_thread::yield();
+        }
+        NotifyWorkAvailable();
+        m_JoinEvent.SpinThenWait([&] { return RootTask.bIsDone.load(std::memory_order_seq_cst); });
+    }
+
+    void NotifyWorkAvailable()
+    {
+        // Deque pushes are not sequentially consistent on their own.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_WorkAvailableEvent.Notify();
+    }
+
+    bool FindTask(Worker& CurrentWorker, Task*& FoundTask)
+    {
+        if (CurrentWorker.Deque.Pop(FoundTask))
+        {
+            return true;
+        }
+
+        const size_t WorkersNum = m_Workers.size();
+        uint32_t& RandomState = CurrentWorker.RandomState;
+        RandomState ^= RandomState << 13;
+        RandomState ^= RandomState >> 17;
+        RandomState ^= RandomState << 5;
+        const size_t FirstVictimIndex = RandomState % WorkersNum;
+        for (size_t i = 0; i < WorkersNum; i++)
+        {
+            Worker& Victim = *m_Workers[(FirstVictimIndex + i) % WorkersNum];
+            if (&Victim != &CurrentWorker && Victim.Deque.Steal(FoundTask))
+            {
+                return true;
+            }
+        }
+
+        return m_InjectionQueue.Pop(FoundTask);
+    }
+
+    void RunWorker(size_t WorkerIndex)
+    {
+        GetWorkerContext() = WorkerContext{ this, WorkerIndex };
+        Worker& CurrentWorker = *m_Workers[WorkerIndex];
+
+        Task* NextTask = nullptr;
+        bool bHasFoundTask = false;
+        while (true)
+        {
+            m_WorkAvailableEvent.SpinThenWait([&]
+            {
+                bHasFoundTask = FindTask(CurrentWorker, NextTask);
+                return bHasFoundTask || m_bIsStopping.load(std::memory_order_seq_cst);
+            });
+            if (!bHasFoundTask)
+            {
+                break;
+            }
+
+            NextTask->Execute(*NextTask);
+            m_JoinEvent.Notify();
+        }
+        GetWorkerContext() = WorkerContext{};
+    }
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+    IEMPMCQueue<Task*> m_InjectionQueue;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<bool> m_bIsStopping{ false };
+    IEEventCount m_WorkAvailableEvent;
+    IEEventCount m_JoinEvent;
+};
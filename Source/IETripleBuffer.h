@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <cstdint>
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Single-producer single-consumer "latest value" exchange where both sides are wait-free.
+    The producer owns a back buffer, the consumer owns a front buffer and the third buffer sits in the middle.
+    Publishing swaps the back buffer with the middle one and marks it fresh,
+    updating swaps the front buffer with the middle one only when a fresh value is there.
+    Values that are overwritten before the consumer picks them up are dropped, nothing is allocated after construction.
+*/
+template<typename T>
+class IETripleBuffer
+{
+private:
+    struct alignas(IE_CACHE_LINE_SIZE) Buffer
+    {
+        T Value;
+    };
+
+public:
+    using ValueType = T;
+    explicit IETripleBuffer(const T& InitialValue = T()) :
+        m_Buffers{ Buffer{ InitialValue }, Buffer{ InitialValue }, Buffer{ InitialValue } }
+    {}
+    IETripleBuffer(const IETripleBuffer&) = delete;
+    IETripleBuffer& operator=(const IETripleBuffer&) = delete;
+
+public:
+    // Producer side. The back buffer can be edited in place and is handed to the consumer by Publish.
+    T& GetWriteBuffer()
+    {
+        return m_Buffers[m_BackIndex].Value;
+    }
+
+    void Publish()
+    {
+        m_BackIndex = m_MiddleState.exchange(m_BackIndex | m_FreshFlag, std::memory_order_acq_rel) & m_IndexMask;
+    }
+
+    void Write(const T& NewValue)
+    {
+        m_Buffers[m_BackIndex].Value = NewValue;
+        Publish();
+    }
+
+    void Write(T&& NewValue)
+    {
+        m_Buffers[m_BackIndex].Value = std::move(NewValue);
+        Publish();
+    }
+
+    // Consumer side. Picks up the latest published value, returns false if nothing new was published since the last update.
+    bool Update()
+    {
+        if ((m_MiddleState.load(std::memory_order_relaxed) & m_FreshFlag) == 0)
+        {
+            return false;
+        }
+        m_FrontIndex = m_MiddleState.exchange(m_FrontIndex, std::memory_order_acq_rel) & m_IndexMask;
+        return true;
+    }
+
+    const T& GetReadBuffer() const
+    {
+        return m_Buffers[m_FrontIndex].Value;
+    }
+
+    // Copies the latest value into Value only if it is fresh.
+    bool Read(T& Value)
+    {
+        if (Update())
+        {
+            Value = m_Buffers[m_FrontIndex].Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool HasFreshValue() const
+    {
+        return (m_MiddleState.load(std::memory_order_acquire) & m_FreshFlag) != 0;
+    }
+
+private:
+    static constexpr uint8_t m_IndexMask = 0b011;
+    static constexpr uint8_t m_FreshFlag = 0b100;
+
+    Buffer m_Buffers[3];
+
+    alignas(IE_CACHE_LINE_SIZE) uint8_t m_BackIndex = 0;
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<uint8_t> m_MiddleState{ 1 };
+    alignas(IE_CACHE_LINE_SIZE) uint8_t m_FrontIndex = 2;
+};
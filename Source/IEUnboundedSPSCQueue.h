@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <limits>
+
+#include "IEConcurrencyCommon.h"
+#include "IEStats.h"
+
+/*
+    Single-producer single-consumer queue without a capacity, built from a linked list of fixed-size segments.
+    Within a segment it works like IESPSCCachedQueue: free-running positions, and each side caching the other side's position.
+    The consumer hands every drained segment back through a lock-free recycle list, which the producer takes whole once its own cache runs out,
+    so a steady flow cycles through the same few segments without allocating, and memory only grows to absorb bursts.
+    Up to MaxRetainedSegmentsNum drained segments are kept for reuse, the consumer frees the others.
+*/
+template <typename T, size_t SegmentSize = 1024, typename Allocator = std::allocator<T>, typename Stats = IENoStats>
+requires (SegmentSize > 0)
+class IEUnboundedSPSCQueue : private Allocator
+{
+private:
+    struct Segment
+    {
+        T* GetElement(size_t Index) { return std::launder(reinterpret_cast<T*>(Storage + Index * sizeof(T))); }
+
+        // Links the next segment of the queue, then the next recycled segment once drained.
+        alignas(IE_CACHE_LINE_SIZE) std::atomic<Segment*> Next{ nullptr };
+        alignas(IE_CACHE_LINE_SIZE) alignas(T) std::byte Storage[SegmentSize * sizeof(T)];
+    };
+    using SegmentAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Segment>;
+
+public:
+    using ValueType = T;
+    explicit IEUnboundedSPSCQueue(size_t MaxRetainedSegmentsNum = std::numeric_limits<size_t>::max(), const Allocator& QueueAllocator = Allocator()) :
+        Allocator(QueueAllocator),
+        m_MaxRetainedSegmentsNum(MaxRetainedSegmentsNum),
+        m_WriteSegment(AllocateSegment()),
+        m_ReadSegment(m_WriteSegment)
+    {}
+    IEUnboundedSPSCQueue(const IEUnboundedSPSCQueue&) = delete;
+    IEUnboundedSPSCQueue& operator=(const IEUnboundedSPSCQueue&) = delete;
+    ~IEUnboundedSPSCQueue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            while (Front())
+            {
+                Discard();
+            }
+        }
+        DeallocateSegments(m_ReadSegment);
+        DeallocateSegments(m_CachedSegments);
+        DeallocateSegments(m_RecycledSegments.load(std::memory_order_relaxed));
+    }
+
+    // Producer only. Always returns true, a new segment is taken from the recycled ones or allocated when the current one is full.
+    template <typename... Args>
+    bool Push(Args&&... _Args)
+    {
+        const size_t WritePosition = m_WritePosition.load(std::memory_order_relaxed);
+        const size_t WriteIndex = WritePosition % SegmentSize;
+        if (IE_UNLIKELY(WriteIndex == 0 && WritePosition != 0))
+        {
+            Segment* NewSegment = AcquireSegment();
+            m_WriteSegment->Next.store(NewSegment, std::memory_order_relaxed);
+            m_WriteSegment = NewSegment;
+        }
+
+        std::allocator_traits<Allocator>::construct(*this, m_WriteSegment->GetElement(WriteIndex), std::forward<Args>(_Args)...);
+        m_WritePosition.store(WritePosition + 1, std::memory_order_release);
+        if constexpr (Stats::bIsEnabled)
+        {
+            m_Stats.OnSize(WritePosition + 1 - m_ReadPosition.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    bool Pop(T& Element)
+    {
+        return Consume([&](T& FrontElement) { Element = std::move(FrontElement); });
+    }
+
+    std::optional<T> Pop()
+    {
+        std::optional<T> Element;
+        Consume([&](T& FrontElement) { Element.emplace(std::move(FrontElement)); });
+        return Element;
+    }
+
+    // Consumer only. Returns the oldest element in place, or nullptr when the queue is empty.
+    // Moving past a drained segment recycles it, so the element stays valid until Discard.
+    T* Front()
+    {
+        const size_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+        if (IE_UNLIKELY(ReadPosition == m_CachedWritePosition))
+        {
+            m_CachedWritePosition = m_WritePosition.load(std::memory_order_acquire);
+            if (ReadPosition == m_CachedWritePosition)
+            {
+                m_Stats.OnPopEmpty();
+                return nullptr;
+            }
+        }
+
+        // The producer links the next segment only when it pushes into it, so the consumer moves on here rather than in Discard.
+        if (IE_UNLIKELY(m_bIsReadSegmentDrained))
+        {
+            Segment* NextSegment = m_ReadSegment->Next.load(std::memory_order_relaxed);
+            RecycleSegment(m_ReadSegment);
+            m_ReadSegment = NextSegment;
+            m_bIsReadSegmentDrained = false;
+        }
+        return m_ReadSegment->GetElement(ReadPosition % SegmentSize);
+    }
+
+    // Consumer only. Destroys the element returned by Front, the queue must not be empty.
+    void Discard()
+    {
+        const size_t ReadPosition = m_ReadPosition.load(std::memory_order_relaxed);
+        std::allocator_traits<Allocator>::destroy(*this, m_ReadSegment->GetElement(ReadPosition % SegmentSize));
+        m_ReadPosition.store(ReadPosition + 1, std::memory_order_release);
+        m_bIsReadSegmentDrained = (ReadPosition + 1) % SegmentSize == 0;
+    }
+
+    // Consumer only. Calls Function(T&) on the oldest element in place and then discards it, returns false when the queue is empty.
+    template <typename FunctionType>
+    bool Consume(FunctionType&& Function)
+    {
+        T* Element = Front();
+        if (!Element)
+        {
+            return false;
+        }
+
+        Function(*Element);
+        Discard();
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_ReadPosition.load(std::memory_order_acquire) == m_WritePosition.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t GetSegmentSize()
+    {
+        return SegmentSize;
+    }
+
+    IEStatsSnapshot GetStats() const
+    {
+        return m_Stats.GetSnapshot();
+    }
+
+private:
+    Segment* AllocateSegment()
+    {
+        SegmentAllocator SegmentAlloc(*this);
+        Segment* NewSegment = std::allocator_traits<SegmentAllocator>::allocate(SegmentAlloc, 1);
+        std::allocator_traits<SegmentAllocator>::construct(SegmentAlloc, NewSegment);
+        return NewSegment;
+    }
+
+    void DeallocateSegments(Segment* FirstSegment)
+    {
+        SegmentAllocator SegmentAlloc(*this);
+        while (FirstSegment)
+        {
+            Segment* NextSegment = FirstSegment->Next.load(std::memory_order_relaxed);
+            std::allocator_traits<SegmentAllocator>::destroy(SegmentAlloc, FirstSegment);
+            std::allocator_traits<SegmentAllocator>::deallocate(SegmentAlloc, FirstSegment, 1);
+            FirstSegment = NextSegment;
+        }
+    }
+
+    // Producer side. Only touches the shared recycle list when its own cache is empty, and then takes the whole list at once.
+    Segment* AcquireSegment()
+    {
+        if (!m_CachedSegments && m_RecycledSegments.load(std::memory_order_relaxed))
+        {
+            m_CachedSegments = m_RecycledSegments.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (!m_CachedSegments)
+        {
+            return AllocateSegment();
+        }
+
+        Segment* CachedSegment = m_CachedSegments;
+        m_CachedSegments = CachedSegment->Next.load(std::memory_order_relaxed);
+        CachedSegment->Next.store(nullptr, std::memory_order_relaxed);
+        m_RetainedSegmentsNum.fetch_sub(1, std::memory_order_relaxed);
+        return CachedSegment;
+    }
+
+    // Consumer side. The producer has moved on to a later segment, so it never touches this one again.
+    void RecycleSegment(Segment* DrainedSegment)
+    {
+        if (m_RetainedSegmentsNum.load(std::memory_order_relaxed) >= m_MaxRetainedSegmentsNum)
+        {
+            DrainedSegment->Next.store(nullptr, std::memory_order_relaxed);
+            DeallocateSegments(DrainedSegment);
+            return;
+        }
+
+        m_RetainedSegmentsNum.fetch_add(1, std::memory_order_relaxed);
+        Segment* Head = m_RecycledSegments.load(std::memory_order_relaxed);
+        do
+        {
+            DrainedSegment->Next.store(Head, std::memory_order_relaxed);
+        } while (!m_RecycledSegments.compare_exchange_weak(Head, DrainedSegment, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+private:
+    const size_t m_MaxRetainedSegmentsNum;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_WritePosition{ 0 };
+    Segment* m_WriteSegment;
+    Segment* m_CachedSegments = nullptr;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<size_t> m_ReadPosition{ 0 };
+    size_t m_CachedWritePosition = 0;
+    Segment* m_ReadSegment;
+    bool m_bIsReadSegmentDrained = false;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<Segment*> m_RecycledSegments{ nullptr };
+    std::atomic<size_t> m_RetainedSegmentsNum{ 0 };
+    IE_NO_UNIQUE_ADDRESS Stats m_Stats;
+};
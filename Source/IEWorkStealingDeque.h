@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include "IEConcurrencyCommon.h"
+
+/*
+    Bounded Chase-Lev work-stealing deque.
+    The owner thread pushes and pops at the bottom wait-free, other threads steal from the top lock-free.
+    Only the owner and a thief racing for the last element contend, and they settle it with a single CAS on the top.
+    Elements are stored as relaxed atomics so a thief reading a slot the owner overwrites is well defined,
+    which is why T must be trivially copyable (typically a task pointer).
+*/
+template <typename T, typename Allocator = std::allocator<T>>
+requires std::is_trivially_copyable_v<T>
+class IEWorkStealingDeque : private Allocator
+{
+private:
+    using Element = std::atomic<T>;
+    using ElementAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Element>;
+
+public:
+    using ValueType = T;
+    // Size is rounded up to a power of two.
+    IEWorkStealingDeque(size_t Size, const Allocator& DequeAllocator = Allocator()) :
+        Allocator(DequeAllocator),
+        m_Capacity(std::bit_ceil(std::max<size_t>(Size, 2))),
+        m_Mask(m_Capacity - 1),
+        m_Data(AllocateElements())
+    {}
+    IEWorkStealingDeque(const IEWorkStealingDeque&) = delete;
+    IEWorkStealingDeque& operator=(const IEWorkStealingDeque&) = delete;
+    ~IEWorkStealingDeque()
+    {
+        ElementAllocator ElementAlloc(*this);
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            std::allocator_traits<ElementAllocator>::destroy(ElementAlloc, m_Data + i);
+        }
+        std::allocator_traits<ElementAllocator>::deallocate(ElementAlloc, m_Data, m_Capacity);
+    }
+
+    // Owner only.
+    bool Push(const T& Value)
+    {
+        const int64_t Bottom = m_Bottom.load(std::memory_order_relaxed);
+        const int64_t Top = m_Top.load(std::memory_order_acquire);
+        if (Bottom - Top >= static_cast<int64_t>(m_Capacity))
+        {
+            return false;
+        }
+
+        m_Data[Bottom & m_Mask].store(Value, std::memory_order_relaxed);
+        m_Bottom.store(Bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner only. Pops the most recently pushed element.
+    bool Pop(T& Value)
+    {
+        const int64_t Bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(Bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t Top = m_Top.load(std::memory_order_relaxed);
+
+        if (Top > Bottom)
+        {
+            m_Bottom.store(Bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Value = m_Data[Bottom & m_Mask].load(std::memory_order_relaxed);
+        if (Top == Bottom)
+        {
+            // Last element, race the thieves for it.
+            const bool bWon = m_Top.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_Bottom.store(Bottom + 1, std::memory_order_relaxed);
+            return bWon;
+        }
+        return true;
+    }
+
+    // Any thread. Steals the least recently pushed element, returns false if the deque is empty or the steal lost a race.
+    bool Steal(T& Value)
+    {
+        int64_t Top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t Bottom = m_Bottom.load(std::memory_order_acquire);
+        if (Top >= Bottom)
+        {
+            return false;
+        }
+
+        Value = m_Data[Top & m_Mask].load(std::memory_order_relaxed);
+        return m_Top.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool IsEmpty() const
+    {
+        return m_Top.load(std::memory_order_acquire) >= m_Bottom.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
+private:
+    Element* AllocateElements()
+    {
+        ElementAllocator ElementAlloc(*this);
+        Element* Elements = std::allocator_traits<ElementAllocator>::allocate(ElementAlloc, m_Capacity);
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            std::allocator_traits<ElementAllocator>::construct(ElementAlloc, Elements + i);
+        }
+        return Elements;
+    }
+
+private:
+    const size_t m_Capacity;
+    const size_t m_Mask;
+    Element* const m_Data;
+
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<int64_t> m_Top{ 0 };
+    alignas(IE_CACHE_LINE_SIZE) std::atomic<int64_t> m_Bottom{ 0 };
+};